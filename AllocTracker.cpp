@@ -0,0 +1,233 @@
+#include "AllocTracker.hpp"
+
+#ifdef DUNGEON_ALLOC_TRACKING
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// Заміна глобальних operator new / delete: усі форми (масиви, nothrow, вирівняні)
+// рахуються й передаються malloc / free. Сам облік купу не використовує: таблиця
+// областей фіксованого розміру, стек областей — вказівники в самих Scope.
+
+namespace alloc_tracking {
+
+namespace {
+
+struct Slot {
+    std::atomic<const char*> name{ nullptr };
+    std::atomic<uint64_t> count{ 0 };
+    std::atomic<uint64_t> bytes{ 0 };
+};
+
+Slot slots[max_scopes];
+std::atomic<uint64_t> total_count{ 0 };
+std::atomic<uint64_t> total_bytes{ 0 };
+
+void print_to_stderr(const char* line) {
+    std::fprintf(stderr, "%s\n", line);
+}
+
+std::atomic<ReportSink> report_sink{ print_to_stderr };
+
+thread_local Scope* current_scope = nullptr;
+
+constexpr size_t overflow_slot = max_scopes - 1;
+
+// Слот для назви: та сама назва (навіть з різних одиниць трансляції) — той самий слот
+size_t slot_for(const char* name) {
+    for (size_t i = 0; i < overflow_slot; ++i) {
+        const char* existing = slots[i].name.load(std::memory_order_acquire);
+        if (!existing) {
+            if (slots[i].name.compare_exchange_strong(existing, name, std::memory_order_acq_rel)) return i;
+        }
+        if (existing == name || std::strcmp(existing, name) == 0) return i;
+    }
+    slots[overflow_slot].name.store("(інші)", std::memory_order_release);
+    return overflow_slot;
+}
+
+Counts load(const Slot& slot) {
+    Counts counts;
+    counts.count = slot.count.load(std::memory_order_relaxed);
+    counts.bytes = slot.bytes.load(std::memory_order_relaxed);
+    return counts;
+}
+
+} // namespace
+
+Counts totals() {
+    Counts counts;
+    counts.count = total_count.load(std::memory_order_relaxed);
+    counts.bytes = total_bytes.load(std::memory_order_relaxed);
+    return counts;
+}
+
+Counts scope_totals(const char* name) {
+    for (const Slot& slot : slots) {
+        const char* existing = slot.name.load(std::memory_order_acquire);
+        if (existing && std::strcmp(existing, name) == 0) return load(slot);
+    }
+    return Counts();
+}
+
+size_t peak_rss_bytes() {
+#if defined(__APPLE__)
+    struct rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? static_cast<size_t>(usage.ru_maxrss) : 0; // Байти
+#elif defined(__unix__)
+    struct rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? static_cast<size_t>(usage.ru_maxrss) * 1024 : 0; // КіБ
+#else
+    return 0;
+#endif
+}
+
+void set_report_sink(ReportSink sink) {
+    report_sink.store(sink, std::memory_order_relaxed);
+}
+
+size_t scope_slot(const char* name) {
+    return slot_for(name);
+}
+
+Scope::Scope(const char* name)
+    : Scope(slot_for(name)) {
+}
+
+Scope::Scope(size_t slot)
+    : slot_(slot < max_scopes ? slot : overflow_slot), parent_(current_scope) {
+    current_scope = this;
+}
+
+Scope::~Scope() {
+    current_scope = parent_;
+}
+
+void Scope::record(size_t bytes) {
+    total_count.fetch_add(1, std::memory_order_relaxed);
+    total_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    for (const Scope* scope = current_scope; scope; scope = scope->parent_) {
+        // Рекурсивна область (та сама назва глибше в стеку) зараховується один раз
+        bool counted = false;
+        for (const Scope* inner = current_scope; inner != scope; inner = inner->parent_) {
+            if (inner->slot_ == scope->slot_) {
+                counted = true;
+                break;
+            }
+        }
+        if (counted) continue;
+        slots[scope->slot_].count.fetch_add(1, std::memory_order_relaxed);
+        slots[scope->slot_].bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+Action::Action(const char* name)
+    : name_(name), scope_(name) {
+    for (size_t i = 0; i < max_scopes; ++i) before_[i] = load(slots[i]);
+}
+
+Action::~Action() {
+    ReportSink sink = report_sink.load(std::memory_order_relaxed);
+    if (!sink) return;
+
+    // Підсумок формується в буфері на стеку — без виділень купи
+    char line[512];
+    const size_t own_slot = slot_for(name_);
+    const Counts own = load(slots[own_slot]);
+    std::snprintf(line, sizeof(line), "[alloc] %s: %llu виділень, %llu байт", name_,
+                  static_cast<unsigned long long>(own.count - before_[own_slot].count),
+                  static_cast<unsigned long long>(own.bytes - before_[own_slot].bytes));
+    sink(line);
+
+    for (size_t i = 0; i < max_scopes; ++i) {
+        const char* scope_name = slots[i].name.load(std::memory_order_acquire);
+        if (!scope_name || i == own_slot) continue;
+        const Counts now = load(slots[i]);
+        if (now.count == before_[i].count) continue;
+        std::snprintf(line, sizeof(line), "[alloc]   %s: %llu виділень, %llu байт", scope_name,
+                      static_cast<unsigned long long>(now.count - before_[i].count),
+                      static_cast<unsigned long long>(now.bytes - before_[i].bytes));
+        sink(line);
+    }
+}
+
+} // namespace alloc_tracking
+
+namespace {
+
+void* tracked_alloc(std::size_t size, std::size_t alignment) {
+    alloc_tracking::Scope::record(size);
+    if (size == 0) size = 1;
+    if (alignment <= alignof(std::max_align_t)) return std::malloc(size);
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    // aligned_alloc вимагає розмір, кратний вирівнюванню
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+}
+
+void tracked_free(void* ptr, std::size_t alignment) {
+#ifdef _WIN32
+    if (alignment > alignof(std::max_align_t)) {
+        _aligned_free(ptr);
+        return;
+    }
+#endif
+    (void)alignment;
+    std::free(ptr);
+}
+
+void* tracked_new(std::size_t size, std::size_t alignment) {
+    void* ptr = tracked_alloc(size, alignment);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+constexpr std::size_t default_alignment = alignof(std::max_align_t);
+
+} // namespace
+
+void* operator new(std::size_t size) { return tracked_new(size, default_alignment); }
+void* operator new[](std::size_t size) { return tracked_new(size, default_alignment); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return tracked_alloc(size, default_alignment); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return tracked_alloc(size, default_alignment); }
+void* operator new(std::size_t size, std::align_val_t al) { return tracked_new(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al) { return tracked_new(size, static_cast<std::size_t>(al)); }
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return tracked_alloc(size, static_cast<std::size_t>(al));
+}
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return tracked_alloc(size, static_cast<std::size_t>(al));
+}
+
+void operator delete(void* ptr) noexcept { tracked_free(ptr, default_alignment); }
+void operator delete[](void* ptr) noexcept { tracked_free(ptr, default_alignment); }
+void operator delete(void* ptr, std::size_t) noexcept { tracked_free(ptr, default_alignment); }
+void operator delete[](void* ptr, std::size_t) noexcept { tracked_free(ptr, default_alignment); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { tracked_free(ptr, default_alignment); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { tracked_free(ptr, default_alignment); }
+void operator delete(void* ptr, std::align_val_t al) noexcept { tracked_free(ptr, static_cast<std::size_t>(al)); }
+void operator delete[](void* ptr, std::align_val_t al) noexcept { tracked_free(ptr, static_cast<std::size_t>(al)); }
+void operator delete(void* ptr, std::size_t, std::align_val_t al) noexcept {
+    tracked_free(ptr, static_cast<std::size_t>(al));
+}
+void operator delete[](void* ptr, std::size_t, std::align_val_t al) noexcept {
+    tracked_free(ptr, static_cast<std::size_t>(al));
+}
+void operator delete(void* ptr, std::align_val_t al, const std::nothrow_t&) noexcept {
+    tracked_free(ptr, static_cast<std::size_t>(al));
+}
+void operator delete[](void* ptr, std::align_val_t al, const std::nothrow_t&) noexcept {
+    tracked_free(ptr, static_cast<std::size_t>(al));
+}
+
+#endif // DUNGEON_ALLOC_TRACKING
@@ -0,0 +1,99 @@
+#ifndef ALLOCTRACKER_HPP
+#define ALLOCTRACKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Облік виділень купи за іменованими областями коду. Вмикається під час збирання:
+// DEFINES += DUNGEON_ALLOC_TRACKING (qmake CONFIG+=alloc_tracking для гри) — тоді
+// AllocTracker.cpp підміняє глобальні operator new / delete. Без визначення макроси
+// DUNGEON_ALLOC_SCOPE / DUNGEON_ALLOC_ACTION нічого не генерують.
+//
+// Виділення зараховується всім активним областям потоку: вкладена область входить
+// і в зовнішню. DUNGEON_ALLOC_ACTION — дія гравця: після виходу з неї друкується
+// підсумок (усього і за вкладеними областями), тож видно, чи хід обійшовся без купи.
+
+namespace alloc_tracking {
+
+struct Counts {
+    uint64_t count = 0; // Викликів operator new
+    uint64_t bytes = 0; // Запитано байт
+};
+
+// Скільки різних назв областей можна відстежувати (решта — в "(інші)")
+constexpr size_t max_scopes = 64;
+
+// Рядок підсумку дії; nullptr — підсумки не друкуються
+using ReportSink = void (*)(const char* line);
+
+#ifdef DUNGEON_ALLOC_TRACKING
+
+// Усі виділення процесу з усіх потоків
+Counts totals();
+
+// Накопичено в області name з початку роботи (з усіх потоків)
+Counts scope_totals(const char* name);
+
+// Пікове RSS процесу в байтах (0, якщо недоступно) — поряд із лічильниками купи,
+// щоб бенчмарки брали весь облік пам'яті з одного місця
+size_t peak_rss_bytes();
+
+// Куди писати підсумки дій (типово stderr)
+void set_report_sink(ReportSink sink);
+
+// Слот таблиці для назви області; та сама назва — той самий слот
+size_t scope_slot(const char* name);
+
+// Область на стеку потоку; name — рядок, що живе до кінця програми (літерал)
+class Scope {
+private:
+    size_t slot_;
+    Scope* parent_;
+
+public:
+    explicit Scope(const char* name);
+    explicit Scope(size_t slot); // Слот від scope_slot (DUNGEON_ALLOC_SCOPE кешує його)
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    // Викликає operator new: зараховує виділення активним областям потоку
+    static void record(size_t bytes);
+};
+
+// Область дії гравця з підсумком після завершення
+class Action {
+private:
+    const char* name_;
+    Counts before_[max_scopes];
+    Scope scope_;
+
+public:
+    explicit Action(const char* name);
+    ~Action();
+
+    Action(const Action&) = delete;
+    Action& operator=(const Action&) = delete;
+};
+
+#define DUNGEON_ALLOC_CONCAT_INNER(a, b) a##b
+#define DUNGEON_ALLOC_CONCAT(a, b) DUNGEON_ALLOC_CONCAT_INNER(a, b)
+// name — сталий рядок: слот шукається один раз на місце виклику
+#define DUNGEON_ALLOC_SCOPE(name) \
+    static const size_t DUNGEON_ALLOC_CONCAT(dungeon_alloc_slot_, __LINE__) = ::alloc_tracking::scope_slot(name); \
+    ::alloc_tracking::Scope DUNGEON_ALLOC_CONCAT(dungeon_alloc_scope_, __LINE__)( \
+        DUNGEON_ALLOC_CONCAT(dungeon_alloc_slot_, __LINE__))
+#define DUNGEON_ALLOC_ACTION(name) \
+    ::alloc_tracking::Action DUNGEON_ALLOC_CONCAT(dungeon_alloc_action_, __LINE__)(name)
+
+#else
+
+#define DUNGEON_ALLOC_SCOPE(name) static_cast<void>(0)
+#define DUNGEON_ALLOC_ACTION(name) static_cast<void>(0)
+
+#endif // DUNGEON_ALLOC_TRACKING
+
+} // namespace alloc_tracking
+
+#endif // ALLOCTRACKER_HPP
@@ -2,46 +2,44 @@
 #define ARCHER_HPP
 
 #include "Player.hpp"
-#include <cstdlib>
-#include <ctime>
+#include "Random.hpp"
 #include <string>
 
 class Archer : public Player {
 private:
-    static bool random_initialized_;
     const int crit_chance_ = 30;
+    Rng own_rng_;  // Якщо генератор гри не передано
+    Rng* rng_;     // Non-owning: генератор гри, через який проходять кидки на крит
 
 public:
-    Archer(const std::string& name)
-        : Player(name, 100, 20, 8) {
-
-        if (!random_initialized_) {
-            std::srand(static_cast<unsigned>(std::time(nullptr)));
-            random_initialized_ = true;
-        }
+    // rng має жити довше за лучника; без нього використовується власний випадковий генератор
+    Archer(const std::string& name, Rng* rng = nullptr)
+        : Player(name, 100, 20, 8), own_rng_(rng ? 0 : Rng::random_seed()), rng_(rng ? rng : &own_rng_) {
     }
 
-    std::string attack(Character& target) override {
-        int roll = std::rand() % 100;
+    // Власний генератор робить вказівник rng_ недійсним після копіювання
+    Archer(const Archer&) = delete;
+    Archer& operator=(const Archer&) = delete;
+
+    int attack(Character& target) override {
+        int roll = rng_->below(100);
         bool is_crit = (roll < crit_chance_);
 
         int damage = attack_power_;
-        std::string prefix = "🏹 " + name_ + " стріляє з лука. ";
-
         if (is_crit) {
             damage *= 2;
-            prefix = "🏹🎯 " + name_ + " завдає КРИТИЧНОГО УДАРУ! ";
         }
 
-        std::string damage_log = target.take_damage(damage);
-        return prefix + damage_log;
+        int dealt = target.take_damage(damage);
+        record_event(is_crit ? CombatEventKind::CriticalShot : CombatEventKind::Shot, target, dealt);
+        return dealt;
     }
 
+    CombatKind get_combat_kind() const override { return CombatKind::Archer; }
+
     std::string get_stats_string() const override {
         return Player::get_stats_string() + " [Клас: Лучник (Шанс крита 30%)]";
     }
 };
 
-inline bool Archer::random_initialized_ = false;
-
 #endif // ARCHER_HPP
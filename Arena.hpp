@@ -0,0 +1,41 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+// Об'єкти, що можуть жити або в купі (new/delete), або в арені (memory_resource).
+// В арені деструктор викликається, але пам'ять не звільняється поштучно —
+// її повертає одним махом release() самої арени (monotonic_buffer_resource).
+struct ArenaDelete {
+    bool in_arena = false;
+
+    template <typename T>
+    void operator()(T* ptr) const {
+        if (in_arena) ptr->~T();
+        else delete ptr;
+    }
+};
+
+template <typename T>
+using arena_ptr = std::unique_ptr<T, ArenaDelete>;
+
+// resource == nullptr -> звичайний new
+template <typename T, typename... Args>
+arena_ptr<T> make_arena(std::pmr::memory_resource* resource, Args&&... args) {
+    if (!resource) {
+        return arena_ptr<T>(new T(std::forward<Args>(args)...), ArenaDelete{ false });
+    }
+
+    void* memory = resource->allocate(sizeof(T), alignof(T));
+    try {
+        return arena_ptr<T>(new (memory) T(std::forward<Args>(args)...), ArenaDelete{ true });
+    } catch (...) {
+        resource->deallocate(memory, sizeof(T), alignof(T));
+        throw;
+    }
+}
+
+#endif // ARENA_HPP
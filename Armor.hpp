@@ -11,12 +11,15 @@ private:
     int defense_;
 
 public:
-    Armor(const std::string& name, const std::string& description, int defense)
+    Armor(std::string_view name, std::string_view description, int defense)
         : Item(name, description), defense_(defense) {
     }
 
     int get_defense() const { return defense_; }
 
+    ItemKind get_item_kind() const override { return ItemKind::Armor; }
+    int get_value() const override { return defense_; }
+
     // ЗМІНА: Повертає рядок замість void
     std::string use(Character* character) override {
         if (character == nullptr) {
@@ -3,6 +3,8 @@
 
 #include <string>
 #include <algorithm> // для std::max
+#include "CombatRules.hpp"
+#include "CombatLog.hpp"
 
 class Character {
 protected:
@@ -12,6 +14,23 @@ protected:
     int attack_power_;
     int defense_;
 
+    CombatLog* combat_log_ = nullptr; // Non-owning; без журналу події не пишуться
+    uint32_t combat_id_ = 0;
+
+    // Запис події в журнал (лише якщо обидва учасники в одному журналі)
+    void record_event(CombatEventKind kind, const Character& target, int amount) const {
+        if (!combat_log_ || target.combat_log_ != combat_log_) return;
+        CombatEvent event;
+        event.actor = combat_id_;
+        event.target = target.combat_id_;
+        event.kind = kind;
+        event.resisted = target.get_physical_resistance() > 0.0f;
+        event.amount = amount;
+        event.hp_after = target.hp_;
+        event.max_hp = target.max_hp_;
+        combat_log_->record(event);
+    }
+
 public:
     Character(const std::string& name, int max_hp, int attack_power, int defense)
         : name_(name), hp_(max_hp), max_hp_(max_hp),
@@ -20,34 +39,37 @@ public:
 
     virtual ~Character() = default;
 
-    // ЗМІНА: Повертає опис атаки
-    virtual std::string attack(Character& target) = 0;
+    // Повертає завдану шкоду; опис атаки — у журналі бою (див. CombatLog)
+    virtual int attack(Character& target) = 0;
+
+    // Тип бійця для CombatStore (SoA-ядер бою без віртуальних викликів)
+    virtual CombatKind get_combat_kind() const = 0;
+
+    // Частка фізичної шкоди, що блокується (0 — без резисту)
+    virtual float get_physical_resistance() const { return 0.0f; }
 
-    // ЗМІНА: Повертає лог отримання пошкоджень
-    virtual std::string take_damage(int amount) {
-        if (amount <= 0) return name_ + " не отримує пошкоджень.";
+    // Повертає реально отриману шкоду
+    virtual int take_damage(int amount) {
+        if (amount <= 0) return 0;
 
         // Захист зменшує шкоду, але мінімум 1 од. проходить
-        int actual_damage = amount - defense_;
-        if (actual_damage < 1) {
-            actual_damage = 1;
-        }
+        int actual_damage = damage_taken(amount, defense_, 0.0f);
 
         hp_ -= actual_damage;
         if (hp_ < 0) {
             hp_ = 0;
         }
 
-        return name_ + " отримує " + std::to_string(actual_damage) + " шкоди! (HP: " + std::to_string(hp_) + "/" + std::to_string(max_hp_) + ")";
+        return actual_damage;
     }
 
     bool is_alive() const {
         return hp_ > 0;
     }
 
-    // ЗМІНА: Повертає лог лікування
-    std::string heal(int amount) {
-        if (amount <= 0) return "";
+    // Повертає, скільки HP відновлено
+    int heal(int amount) {
+        if (amount <= 0) return 0;
 
         int old_hp = hp_;
         hp_ += amount;
@@ -56,10 +78,20 @@ public:
         }
 
         int healed_amount = hp_ - old_hp;
+        record_event(CombatEventKind::Heal, *this, healed_amount);
+        return healed_amount;
+    }
 
-        return name_ + " відновлює " + std::to_string(healed_amount) + " HP. (HP: " + std::to_string(hp_) + "/" + std::to_string(max_hp_) + ")";
+    // Підключає журнал бою (повторний виклик з тим самим журналом нічого не робить)
+    void attach_combat_log(CombatLog* log) {
+        if (log == combat_log_) return;
+        combat_log_ = log;
+        if (log) combat_id_ = log->register_actor(name_);
     }
 
+    CombatLog* get_combat_log() const { return combat_log_; }
+    uint32_t get_combat_id() const { return combat_id_; }
+
     // ЗМІНА: Повертає форматований рядок статистики
     virtual std::string get_stats_string() const {
         return name_ + " | HP: " + std::to_string(hp_) + "/" + std::to_string(max_hp_) +
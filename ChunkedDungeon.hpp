@@ -0,0 +1,251 @@
+#ifndef CHUNKEDDUNGEON_HPP
+#define CHUNKEDDUNGEON_HPP
+
+#include "GameMap.hpp"
+#include "Random.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Потокове (чанкове) підземелля необмеженого розміру.
+// Світ — нескінченний ланцюжок чанків 0, 1, 2, ...; чанк — звичайна GameMap на
+// chunk_size кімнат, згенерована з Rng(chunk_seed(seed, id)), тож той самий
+// (seed, id) завжди дає той самий чанк. Чанк генерується при першому зверненні
+// і вивантажується, коли гравець відходить далі ніж на keep_radius чанків.
+//
+// Між сусідніми чанками c і c + 1 є коридор "остання кімната c -> перша c + 1"
+// плюс кілька випадкових порталів, які теж виводяться лише з (seed, c), тож
+// обидва боки бачать однакові переходи без жодного спільного стану.
+//
+// Після вивантаження від чанка лишається тільки дельта (які вороги переможені і
+// які предмети підібрані) — по байту на кімнату і лише для змінених чанків.
+// Без обмеження дельти ростуть разом із пройденим світом (chunk_size байт плюс
+// запис хеш-таблиці на кожен змінений чанк). max_deltas > 0 обмежує їх кількість:
+// зайві дельти найдальших від гравця чанків забуваються, і такий чанк при поверненні
+// генерується заново — з воскреслими ворогами й предметами на місці.
+//
+// Поки що це окрема структура: GameEngine грає на звичайній GameMap.
+
+struct RoomRef {
+    uint64_t chunk = 0;
+    uint32_t room = 0;
+
+    bool operator==(const RoomRef& other) const { return chunk == other.chunk && room == other.room; }
+    bool operator!=(const RoomRef& other) const { return !(*this == other); }
+};
+
+class ChunkedDungeon {
+private:
+    // Перехід з кімнати room цього чанка до кімнати іншого чанка
+    struct Link {
+        uint32_t room;
+        RoomRef target;
+    };
+
+    struct Chunk {
+        std::unique_ptr<GameMap> map;
+        std::vector<Link> links;             // Відсортовані за room
+        std::vector<uint8_t> loaded_state;   // Прапорці кімнат на момент завантаження
+        bool restored = false;               // Завантажений з дельти
+    };
+
+    enum : uint8_t { has_enemy_flag = 1, has_item_flag = 2 };
+
+    std::vector<uint8_t> room_state(const GameMap& map) const {
+        std::vector<uint8_t> state(chunk_size_);
+        for (uint32_t room = 0; room < chunk_size_; ++room) {
+            const MapNode* node = map.get_node_by_id(static_cast<int>(room));
+            state[room] = static_cast<uint8_t>((node->has_enemy() ? has_enemy_flag : 0) |
+                                               (node->has_item() ? has_item_flag : 0));
+        }
+        return state;
+    }
+
+    uint64_t seed_;
+    uint32_t chunk_size_;
+    uint32_t keep_radius_;
+    uint32_t portals_per_boundary_;
+    size_t max_deltas_;
+
+    std::unordered_map<uint64_t, Chunk> loaded_;
+    std::unordered_map<uint64_t, std::vector<uint8_t>> deltas_; // Стан вивантажених змінених чанків
+    uint64_t player_chunk_ = 0;
+    uint64_t chunks_generated_ = 0;
+    uint64_t deltas_dropped_ = 0;
+
+    static uint64_t distance(uint64_t a, uint64_t b) { return a > b ? a - b : b - a; }
+
+    static uint64_t mix(uint64_t seed, uint64_t chunk_id, uint64_t stream) {
+        uint64_t x = seed ^ (chunk_id * 0xD1B54A32D192ED03ull) ^ (stream * 0x8CB92BA72F3D8DD7ull);
+        Rng::splitmix64(x);
+        return Rng::splitmix64(x);
+    }
+
+    // Переходи між чанками c і c + 1 (з боку c — from, з боку c + 1 — to)
+    std::vector<std::pair<uint32_t, uint32_t>> boundary_links(uint64_t chunk_id) const {
+        std::vector<std::pair<uint32_t, uint32_t>> links;
+        links.emplace_back(chunk_size_ - 1, 0);
+
+        Rng rng(mix(seed_, chunk_id, 1));
+        for (uint32_t i = 0; i < portals_per_boundary_; ++i) {
+            uint32_t from = rng.below(chunk_size_);
+            uint32_t to = rng.below(chunk_size_);
+            if (std::find(links.begin(), links.end(), std::make_pair(from, to)) == links.end()) {
+                links.emplace_back(from, to);
+            }
+        }
+        return links;
+    }
+
+    Chunk& load(uint64_t chunk_id) {
+        auto it = loaded_.find(chunk_id);
+        if (it != loaded_.end()) return it->second;
+
+        Chunk chunk;
+        chunk.map = std::make_unique<GameMap>();
+        Rng rng(chunk_seed(seed_, chunk_id));
+        const int rooms = static_cast<int>(chunk_size_);
+        chunk.map->generate_map(rooms, rooms / 2, rooms / 2 + 1, rng);
+        ++chunks_generated_;
+
+        // Відновлюємо переможених ворогів і підібрані предмети
+        auto delta = deltas_.find(chunk_id);
+        if (delta != deltas_.end()) {
+            for (uint32_t room = 0; room < chunk_size_; ++room) {
+                MapNode* node = chunk.map->get_node_by_id(static_cast<int>(room));
+                if (!(delta->second[room] & has_enemy_flag)) chunk.map->remove_enemy(*node);
+                if (!(delta->second[room] & has_item_flag)) chunk.map->remove_item(*node);
+            }
+            deltas_.erase(delta);
+            chunk.restored = true;
+        }
+        chunk.loaded_state = room_state(*chunk.map);
+
+        if (chunk_id > 0) {
+            for (const auto& link : boundary_links(chunk_id - 1)) {
+                chunk.links.push_back(Link{ link.second, RoomRef{ chunk_id - 1, link.first } });
+            }
+        }
+        for (const auto& link : boundary_links(chunk_id)) {
+            chunk.links.push_back(Link{ link.first, RoomRef{ chunk_id + 1, link.second } });
+        }
+        std::stable_sort(chunk.links.begin(), chunk.links.end(),
+                         [](const Link& a, const Link& b) { return a.room < b.room; });
+
+        return loaded_.emplace(chunk_id, std::move(chunk)).first->second;
+    }
+
+    // Дельта зберігається, лише якщо чанк відрізняється від свіжої генерації
+    void unload(uint64_t chunk_id, Chunk& chunk) {
+        std::vector<uint8_t> state = room_state(*chunk.map);
+        if (chunk.restored || state != chunk.loaded_state) {
+            deltas_[chunk_id] = std::move(state);
+        }
+        if (max_deltas_ == 0) return;
+        while (deltas_.size() > max_deltas_) {
+            auto farthest = std::max_element(deltas_.begin(), deltas_.end(), [this](const auto& a, const auto& b) {
+                return distance(a.first, player_chunk_) < distance(b.first, player_chunk_);
+            });
+            deltas_.erase(farthest);
+            ++deltas_dropped_;
+        }
+    }
+
+public:
+    static constexpr uint32_t default_chunk_size = 64;
+    static constexpr uint32_t default_keep_radius = 2;
+
+    // max_deltas == 0 — зберігати зміни всіх чанків без обмеження
+    explicit ChunkedDungeon(uint64_t seed, uint32_t chunk_size = default_chunk_size,
+                            uint32_t keep_radius = default_keep_radius, uint32_t portals_per_boundary = 2,
+                            size_t max_deltas = 0)
+        : seed_(seed), chunk_size_(chunk_size), keep_radius_(keep_radius),
+        portals_per_boundary_(portals_per_boundary), max_deltas_(max_deltas) {
+        if (chunk_size_ < 2) {
+            throw std::runtime_error("Chunk must contain at least 2 rooms");
+        }
+    }
+
+    ChunkedDungeon(const ChunkedDungeon&) = delete;
+    ChunkedDungeon& operator=(const ChunkedDungeon&) = delete;
+
+    // Зерно чанка: залежить лише від зерна світу і номера чанка
+    static uint64_t chunk_seed(uint64_t seed, uint64_t chunk_id) {
+        return mix(seed, chunk_id, 0);
+    }
+
+    // Чанк (генерується при першому зверненні)
+    GameMap& chunk(uint64_t chunk_id) { return *load(chunk_id).map; }
+
+    MapNode* get_room(const RoomRef& ref) {
+        if (ref.room >= chunk_size_) return nullptr;
+        return chunk(ref.chunk).get_node_by_id(static_cast<int>(ref.room));
+    }
+
+    // Обхід сусідів: спершу кімнати свого чанка, потім переходи в сусідні чанки. fn(RoomRef)
+    template <typename Fn>
+    void for_each_neighbor(const RoomRef& ref, Fn&& fn) {
+        Chunk& current = load(ref.chunk);
+        current.map->for_each_neighbor(static_cast<int>(ref.room), [&](MapNode* node) {
+            fn(RoomRef{ ref.chunk, node->get_id() });
+        });
+        auto first = std::lower_bound(current.links.begin(), current.links.end(), ref.room,
+                                      [](const Link& link, uint32_t room) { return link.room < room; });
+        for (auto it = first; it != current.links.end() && it->room == ref.room; ++it) {
+            fn(it->target);
+        }
+    }
+
+    size_t get_num_neighbors(const RoomRef& ref) {
+        size_t count = 0;
+        for_each_neighbor(ref, [&count](const RoomRef&) { ++count; });
+        return count;
+    }
+
+    // Сусід за індексом виходу; false, якщо такого виходу немає
+    bool get_neighbor(const RoomRef& ref, size_t index, RoomRef& out) {
+        size_t i = 0;
+        bool found = false;
+        for_each_neighbor(ref, [&](const RoomRef& neighbor) {
+            if (i++ == index) {
+                out = neighbor;
+                found = true;
+            }
+        });
+        return found;
+    }
+
+    // Гравець у чанку chunk_id: довантажує околицю і вивантажує далекі чанки
+    void set_player_chunk(uint64_t chunk_id) {
+        player_chunk_ = chunk_id;
+        for (auto it = loaded_.begin(); it != loaded_.end();) {
+            if (distance(it->first, chunk_id) > keep_radius_) {
+                unload(it->first, it->second);
+                it = loaded_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        uint64_t first = chunk_id > keep_radius_ ? chunk_id - keep_radius_ : 0;
+        for (uint64_t id = first; id <= chunk_id + keep_radius_; ++id) {
+            load(id);
+        }
+    }
+
+    bool is_loaded(uint64_t chunk_id) const { return loaded_.count(chunk_id) > 0; }
+    size_t get_loaded_chunks() const { return loaded_.size(); }
+    size_t get_stored_deltas() const { return deltas_.size(); }
+    uint64_t get_dropped_deltas() const { return deltas_dropped_; }
+    uint64_t get_chunks_generated() const { return chunks_generated_; }
+    uint32_t get_chunk_size() const { return chunk_size_; }
+    uint64_t get_seed() const { return seed_; }
+};
+
+#endif // CHUNKEDDUNGEON_HPP
@@ -0,0 +1,93 @@
+#ifndef COMBATKERNELS_HPP
+#define COMBATKERNELS_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+#include "CombatRules.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DUNGEON_AVX2_DISPATCH 1
+#include <immintrin.h>
+#elif defined(__AVX2__)
+#define DUNGEON_AVX2_STATIC 1
+#include <immintrin.h>
+#endif
+
+// Пакетне застосування шкоди до масивів бійців (SoA, див. CombatStore):
+//   hp[i] -= damage_taken(amount[i], defense[i], resistance[i]), HP не нижче 0.
+// amount[i] <= 0 означає "цього бійця не б'ють". Результат біт-у-біт збігається
+// з Character::take_damage / Wraith::take_damage (перевірка: dungeon_bench combat-simd).
+//
+// На x86 з GCC/Clang версія AVX2 обирається під час виконання, з MSVC — якщо
+// збірка має /arch:AVX2; інакше працює скалярний цикл.
+
+inline void apply_damage_batch_scalar(int32_t* hp, const int32_t* defense, const float* resistance,
+                                      const int32_t* amount, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        int new_hp = hp[i] - damage_taken(amount[i], defense[i], resistance[i]);
+        hp[i] = new_hp < 0 ? 0 : new_hp;
+    }
+}
+
+#if defined(DUNGEON_AVX2_DISPATCH) || defined(DUNGEON_AVX2_STATIC)
+
+#if defined(DUNGEON_AVX2_DISPATCH)
+__attribute__((target("avx2")))
+#endif
+inline void apply_damage_batch_avx2(int32_t* hp, const int32_t* defense, const float* resistance,
+                                    const int32_t* amount, size_t count) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256 zero_ps = _mm256_setzero_ps();
+    const __m256 one_ps = _mm256_set1_ps(1.0f);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i amt = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(amount + i));
+        __m256i def = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(defense + i));
+        __m256 res = _mm256_loadu_ps(resistance + i);
+        __m256i health = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hp + i));
+
+        // Резист: static_cast<int>(amount * (1 - resistance)), мінімум 1
+        __m256 scaled_ps = _mm256_mul_ps(_mm256_cvtepi32_ps(amt), _mm256_sub_ps(one_ps, res));
+        __m256i scaled = _mm256_max_epi32(_mm256_cvttps_epi32(scaled_ps), one);
+        __m256i has_resistance = _mm256_castps_si256(_mm256_cmp_ps(res, zero_ps, _CMP_GT_OQ));
+        __m256i reduced = _mm256_blendv_epi8(amt, scaled, has_resistance);
+
+        // Захист, мінімум 1 од. шкоди; нуль, якщо атаки не було
+        __m256i actual = _mm256_max_epi32(_mm256_sub_epi32(reduced, def), one);
+        actual = _mm256_and_si256(actual, _mm256_cmpgt_epi32(amt, zero));
+
+        health = _mm256_max_epi32(_mm256_sub_epi32(health, actual), zero);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(hp + i), health);
+    }
+
+    apply_damage_batch_scalar(hp + i, defense + i, resistance + i, amount + i, count - i);
+}
+
+#endif
+
+inline bool combat_kernels_use_avx2() {
+#if defined(DUNGEON_AVX2_DISPATCH)
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#elif defined(DUNGEON_AVX2_STATIC)
+    return true;
+#else
+    return false;
+#endif
+}
+
+inline void apply_damage_batch(int32_t* hp, const int32_t* defense, const float* resistance,
+                               const int32_t* amount, size_t count) {
+#if defined(DUNGEON_AVX2_DISPATCH) || defined(DUNGEON_AVX2_STATIC)
+    if (combat_kernels_use_avx2()) {
+        apply_damage_batch_avx2(hp, defense, resistance, amount, count);
+        return;
+    }
+#endif
+    apply_damage_batch_scalar(hp, defense, resistance, amount, count);
+}
+
+#endif // COMBATKERNELS_HPP
@@ -0,0 +1,146 @@
+#ifndef COMBATLOG_HPP
+#define COMBATLOG_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Структурований журнал бою. attack / take_damage / heal більше не будують рядків:
+// вони лише дописують компактний запис у кільцевий буфер, а текст формується
+// (render) тільки тоді, коли його справді показують — UI або лог.
+// Пакетна симуляція без UI не платить за форматування нічого.
+
+enum class CombatEventKind : uint8_t {
+    PowerStrike,   // Потужний удар воїна
+    Spell,         // Закляття мага (ігнорує захист)
+    Shot,          // Постріл лучника
+    CriticalShot,  // Критичний постріл лучника
+    QuickStrike,   // Швидка атака гобліна
+    BrutalStrike,  // Брутальний удар орка
+    Drain,         // Спектральне висмоктування примари
+    Heal           // Лікування (вампіризм, зілля)
+};
+
+// actor — хто діє, target — на кого; amount — реальна шкода або відновлені HP
+// (для Spell — сила закляття, як її завжди показував текст); hp_after — HP цілі
+// після події; resisted — ціль з фізичним резистом (примара) описує удар по собі
+// власним текстом
+struct CombatEvent {
+    uint32_t actor = 0;
+    uint32_t target = 0;
+    CombatEventKind kind = CombatEventKind::PowerStrike;
+    bool resisted = false;
+    int32_t amount = 0;
+    int32_t hp_after = 0;
+    int32_t max_hp = 0;
+};
+
+class CombatLog {
+private:
+    std::vector<CombatEvent> ring_;    // Розмір — степінь двійки
+    uint64_t total_ = 0;               // Скільки подій записано за весь час
+    std::vector<std::string> actors_;  // Імена учасників за id; однакові імена — один id
+
+    static size_t round_up_pow2(size_t value) {
+        size_t result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+public:
+    static constexpr size_t default_capacity = 256;
+
+    explicit CombatLog(size_t capacity = default_capacity)
+        : ring_(round_up_pow2(capacity == 0 ? 1 : capacity)) {
+    }
+
+    // Реєструє учасника бою; ім'я зберігається один раз, а не в кожному записі.
+    // Текст події залежить лише від імені, тож усі "Goblin" ділять один id: після
+    // першого бою з кожним видом ворога реєстрація нічого не виділяє
+    uint32_t register_actor(const std::string& name) {
+        for (size_t id = 0; id < actors_.size(); ++id) {
+            if (actors_[id] == name) return static_cast<uint32_t>(id);
+        }
+        actors_.push_back(name);
+        return static_cast<uint32_t>(actors_.size() - 1);
+    }
+
+    const std::string& actor_name(uint32_t id) const { return actors_.at(id); }
+
+    void record(const CombatEvent& event) {
+        ring_[static_cast<size_t>(total_) & (ring_.size() - 1)] = event;
+        ++total_;
+    }
+
+    // Скидає події (нова гра). Імена учасників лишаються: ті самі гравець і вороги
+    // наступної гри отримують ті самі id без нових виділень
+    void clear() {
+        total_ = 0;
+    }
+
+    size_t capacity() const { return ring_.size(); }
+    uint64_t total_recorded() const { return total_; }
+
+    // Найстаріший порядковий номер, що ще лежить у буфері
+    uint64_t oldest() const {
+        return total_ > ring_.size() ? total_ - ring_.size() : 0;
+    }
+
+    // Подія з порядковим номером sequence (oldest() <= sequence < total_recorded())
+    const CombatEvent& at(uint64_t sequence) const {
+        return ring_[static_cast<size_t>(sequence) & (ring_.size() - 1)];
+    }
+
+    // Викликає fn(const CombatEvent&) для подій, записаних починаючи з sequence
+    // (застарілі, вже перезаписані події пропускаються). Повертає новий курсор.
+    template <typename Fn>
+    uint64_t for_each_since(uint64_t sequence, Fn&& fn) const {
+        uint64_t from = sequence < oldest() ? oldest() : sequence;
+        for (uint64_t i = from; i < total_; ++i) {
+            fn(at(i));
+        }
+        return total_;
+    }
+
+    // Текст події — лише на вимогу; дослівно той, що колись повертали attack / heal
+    // (перевірка: simulator --verify)
+    std::string render(const CombatEvent& event) const {
+        const std::string& actor = actor_name(event.actor);
+        const std::string& target = actor_name(event.target);
+        const std::string hp = " (HP: " + std::to_string(event.hp_after) + "/" + std::to_string(event.max_hp) + ")";
+        std::string damage;
+        if (event.amount <= 0) {
+            damage = target + " не отримує пошкоджень.";
+        } else if (event.resisted) {
+            damage = "👻 " + target + " проходить крізь атаку (50% резист)! Отримує лише " +
+                std::to_string(event.amount) + " шкоди." + hp;
+        } else {
+            damage = target + " отримує " + std::to_string(event.amount) + " шкоди!" + hp;
+        }
+
+        switch (event.kind) {
+        case CombatEventKind::PowerStrike:
+            return "⚔️ " + actor + " (Воїн) завдає ПОТУЖНОГО УДАРУ! " + damage;
+        case CombatEventKind::Spell:
+            return "🔥 " + actor + " кастує закляття! " + target + " отримує " +
+                std::to_string(event.amount) + " шкоди (ІГНОР ЗАХИСТУ).";
+        case CombatEventKind::Shot:
+            return "🏹 " + actor + " стріляє з лука. " + damage;
+        case CombatEventKind::CriticalShot:
+            return "🏹🎯 " + actor + " завдає КРИТИЧНОГО УДАРУ! " + damage;
+        case CombatEventKind::QuickStrike:
+            return "👺 " + actor + " (Гоблін) швидко атакує! " + damage;
+        case CombatEventKind::BrutalStrike:
+            return "👹 " + actor + " (Орк) завдає БРУТАЛЬНОГО УДАРУ! " + damage;
+        case CombatEventKind::Drain:
+            return "👻 " + actor + " (Примара) використовує СПЕКТРАЛЬНЕ ВИСМОКТУВАННЯ! " + damage +
+                " (Примара відновила сили)";
+        case CombatEventKind::Heal:
+            return target + " відновлює " + std::to_string(event.amount) + " HP." + hp;
+        }
+        return std::string();
+    }
+};
+
+#endif // COMBATLOG_HPP
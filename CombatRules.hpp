@@ -0,0 +1,37 @@
+#ifndef COMBATRULES_HPP
+#define COMBATRULES_HPP
+
+#include <cstdint>
+
+// Спільні правила бою: ними користуються і класи Character, і CombatStore,
+// тому обидва шляхи рахують шкоду однаково.
+
+// Тип бійця для ядер без віртуальних викликів
+enum class CombatKind : uint8_t {
+    Warrior,
+    Mage,
+    Archer,
+    Goblin,
+    Orc,
+    Wraith
+};
+
+constexpr int combat_kind_count = 6;
+
+// Шкода, яку реально отримує ціль від атаки силою amount.
+// resistance — частка фізичної шкоди, що блокується (0 — без резисту).
+// Захист зменшує шкоду, але якщо amount > 0, мінімум 1 од. проходить.
+inline int damage_taken(int amount, int defense, float resistance) {
+    if (amount <= 0) return 0;
+
+    int reduced = amount;
+    if (resistance > 0.0f) {
+        reduced = static_cast<int>(amount * (1.0f - resistance));
+        if (reduced < 1) reduced = 1;
+    }
+
+    int actual = reduced - defense;
+    return actual < 1 ? 1 : actual;
+}
+
+#endif // COMBATRULES_HPP
@@ -0,0 +1,156 @@
+#ifndef COMBATSTORE_HPP
+#define COMBATSTORE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "Character.hpp"
+#include "CombatRules.hpp"
+#include "CombatKernels.hpp"
+#include "Random.hpp"
+
+// Сховище бійців у вигляді структури масивів (SoA) для пакетної симуляції.
+// Кожне поле лежить окремим суцільним масивом, а атака — це switch за
+// CombatKind замість віртуальних attack/take_damage, тож масовий розрахунок
+// боїв іде по кешу підряд і без непрямих викликів.
+//
+// Ієрархія Character лишається фасадом: add(const Character&) знімає стан
+// об'єкта, sync_to() повертає HP назад. Правила повторюють відповідні класи
+// (Warrior, Mage, Archer, Goblin, Orc, Wraith).
+class CombatStore {
+private:
+    std::vector<int32_t> hp_;
+    std::vector<int32_t> max_hp_;
+    std::vector<int32_t> attack_;
+    std::vector<int32_t> defense_;
+    std::vector<float> resistance_;
+    std::vector<CombatKind> kind_;
+
+    static constexpr int archer_crit_chance = 30;
+
+public:
+    using index_type = uint32_t;
+
+    CombatStore() = default;
+
+    void reserve(size_t count) {
+        hp_.reserve(count);
+        max_hp_.reserve(count);
+        attack_.reserve(count);
+        defense_.reserve(count);
+        resistance_.reserve(count);
+        kind_.reserve(count);
+    }
+
+    void clear() {
+        hp_.clear();
+        max_hp_.clear();
+        attack_.clear();
+        defense_.clear();
+        resistance_.clear();
+        kind_.clear();
+    }
+
+    index_type add(CombatKind kind, int hp, int max_hp, int attack, int defense, float resistance) {
+        hp_.push_back(hp);
+        max_hp_.push_back(max_hp);
+        attack_.push_back(attack);
+        defense_.push_back(defense);
+        resistance_.push_back(resistance);
+        kind_.push_back(kind);
+        return static_cast<index_type>(hp_.size() - 1);
+    }
+
+    index_type add(const Character& character) {
+        return add(character.get_combat_kind(), character.get_hp(), character.get_max_hp(),
+                   character.get_attack_power(), character.get_defense(),
+                   character.get_physical_resistance());
+    }
+
+    // Повертає результат бою об'єкту-фасаду
+    void sync_to(index_type index, Character& character) const {
+        character.set_hp(hp_[index]);
+    }
+
+    size_t size() const { return hp_.size(); }
+
+    bool is_alive(index_type index) const { return hp_[index] > 0; }
+    int get_hp(index_type index) const { return hp_[index]; }
+    int get_max_hp(index_type index) const { return max_hp_[index]; }
+    CombatKind get_kind(index_type index) const { return kind_[index]; }
+
+    // Сирі масиви для векторних ядер
+    int32_t* hp_data() { return hp_.data(); }
+    const int32_t* max_hp_data() const { return max_hp_.data(); }
+    const int32_t* attack_data() const { return attack_.data(); }
+    const int32_t* defense_data() const { return defense_.data(); }
+    const float* resistance_data() const { return resistance_.data(); }
+    const CombatKind* kind_data() const { return kind_.data(); }
+
+    // Як Character::take_damage / Wraith::take_damage; повертає завдану шкоду
+    int take_damage(index_type target, int amount) {
+        int actual = damage_taken(amount, defense_[target], resistance_[target]);
+        hp_[target] -= actual;
+        if (hp_[target] < 0) hp_[target] = 0;
+        return actual;
+    }
+
+    // Шкода всім бійцям одним векторним проходом: amounts[i] — сила атаки по бійцю i
+    // (<= 0 — не атакований). amounts має містити size() елементів.
+    void apply_damage_all(const int32_t* amounts) {
+        apply_damage_batch(hp_.data(), defense_.data(), resistance_.data(), amounts, hp_.size());
+    }
+
+    // Як Character::heal; повертає, скільки HP відновлено
+    int heal(index_type target, int amount) {
+        if (amount <= 0) return 0;
+        int old_hp = hp_[target];
+        hp_[target] += amount;
+        if (hp_[target] > max_hp_[target]) hp_[target] = max_hp_[target];
+        return hp_[target] - old_hp;
+    }
+
+    // Одна атака attacker -> target за правилами класу атакуючого; повертає завдану шкоду
+    int attack(index_type attacker, index_type target, Rng& rng) {
+        const int power = attack_[attacker];
+        switch (kind_[attacker]) {
+        case CombatKind::Warrior:
+            return take_damage(target, static_cast<int>(power * 1.2));
+        case CombatKind::Mage: {
+            // Магія ігнорує захист і резист
+            int old_hp = hp_[target];
+            int new_hp = old_hp - power;
+            if (new_hp > max_hp_[target]) new_hp = max_hp_[target];
+            if (new_hp < 0) new_hp = 0;
+            hp_[target] = new_hp;
+            return old_hp - new_hp;
+        }
+        case CombatKind::Archer: {
+            bool is_crit = static_cast<int>(rng.below(100)) < archer_crit_chance;
+            return take_damage(target, is_crit ? power * 2 : power);
+        }
+        case CombatKind::Goblin:
+            return take_damage(target, power);
+        case CombatKind::Orc:
+            return take_damage(target, static_cast<int>(power * 1.1));
+        case CombatKind::Wraith: {
+            int dealt = take_damage(target, power);
+            heal(attacker, power / 3); // Вампіризм
+            return dealt;
+        }
+        }
+        return 0;
+    }
+
+    // Один раунд для count пар бійців: attackers[i] б'є targets[i], якщо обидва живі
+    void attack_batch(const index_type* attackers, const index_type* targets, size_t count, Rng& rng) {
+        for (size_t i = 0; i < count; ++i) {
+            if (hp_[attackers[i]] > 0 && hp_[targets[i]] > 0) {
+                attack(attackers[i], targets[i], rng);
+            }
+        }
+    }
+};
+
+#endif // COMBATSTORE_HPP
@@ -0,0 +1,86 @@
+#ifndef DISTANCEFIELD_HPP
+#define DISTANCEFIELD_HPP
+
+#include "Graph.hpp"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+// Поле відстаней (у кількості переходів) від множини джерел до кожного вузла
+// компактного Graph. Будується одним multi-source BFS, після чого запит — це
+// читання з масиву за щільним індексом вузла.
+// Для неорієнтованого графа (як у GameMap) це одночасно й відстань "до" джерел.
+class DistanceField {
+private:
+    std::vector<uint32_t> distance_;
+    std::vector<uint32_t> queue_;
+
+    template <typename T>
+    void propagate(const Graph<T>& graph, size_t head) {
+        while (head < queue_.size()) {
+            uint32_t current = queue_[head++];
+            uint32_t next_distance = distance_[current] + 1;
+            graph.for_each_neighbor_index(current, [&](uint32_t neighbor, graph_weight_t) {
+                if (next_distance < distance_[neighbor]) {
+                    distance_[neighbor] = next_distance;
+                    queue_.push_back(neighbor);
+                }
+            });
+        }
+        queue_.clear();
+    }
+
+public:
+    static constexpr uint32_t unreachable = std::numeric_limits<uint32_t>::max();
+
+    DistanceField() = default;
+
+    template <typename T>
+    void build(const Graph<T>& graph, const std::vector<T>& sources) {
+        distance_.assign(graph.size(), unreachable);
+        queue_.clear();
+        queue_.reserve(graph.size());
+
+        for (const T& source : sources) {
+            uint32_t index = graph.node_index(source);
+            if (index == Graph<T>::npos_index) {
+                throw std::runtime_error("Source node does not exist");
+            }
+            if (distance_[index] != 0) {
+                distance_[index] = 0;
+                queue_.push_back(index);
+            }
+        }
+        propagate(graph, 0);
+    }
+
+    // Оновлення після додавання ребра from -> to (граф уже містить це ребро).
+    // Нове ребро може лише скоротити відстані, тому перераховується тільки
+    // та частина поля, яку воно покращило.
+    template <typename T>
+    void on_edge_added(const Graph<T>& graph, const T& from, const T& to) {
+        uint32_t u = graph.node_index(from);
+        uint32_t v = graph.node_index(to);
+        if (u == Graph<T>::npos_index || v == Graph<T>::npos_index) {
+            throw std::runtime_error("Node does not exist");
+        }
+        if (distance_.size() != graph.size()) {
+            throw std::runtime_error("Distance field does not match the graph");
+        }
+        if (distance_[u] == unreachable || distance_[u] + 1 >= distance_[v]) return;
+
+        distance_[v] = distance_[u] + 1;
+        queue_.push_back(v);
+        propagate(graph, 0);
+    }
+
+    uint32_t at(size_t index) const { return distance_[index]; }
+
+    bool is_reachable(size_t index) const { return distance_[index] != unreachable; }
+
+    size_t size() const { return distance_.size(); }
+};
+
+#endif // DISTANCEFIELD_HPP
@@ -4,59 +4,57 @@
 #include <QObject>
 #include <QString>
 #include <QVector>
-#include <memory>
 #include <string>
-#include <vector>
-
-// Підключаємо ваші існуючі класи
-#include "GameMap.hpp"
-#include "Player.hpp"
-#include "Warrior.hpp"
-#include "Mage.hpp"
-#include "Archer.hpp"
-#include "Enemy.hpp" // Переконайтеся, що цей файл підключено
-#include "Item.hpp"
-
-class Game : public QObject {
+#include <string_view>
+
+// Уся логіка гри живе в GameEngine (без Qt); Game лише перетворює її події на сигнали
+#include "GameEngine.hpp"
+#include "Trace.hpp"
+
+class Game : public QObject, private GameEventListener {
     Q_OBJECT
 
 public:
     explicit Game(QObject* parent = nullptr)
-        : QObject(parent), current_room_id_(0), game_running_(false), final_room_id_(0) {
+        : QObject(parent) {
+        engine_.set_listener(this);
     }
 
     // --- ГЕТТЕРИ ДЛЯ ІНТЕРФЕЙСУ (UI буде їх смикати, щоб оновити віджети) ---
 
-    int getPlayerHP() const { return player_ ? player_->get_hp() : 0; }
-    int getPlayerMaxHP() const { return player_ ? player_->get_max_hp() : 100; }
+    bool isRunning() const { return engine_.is_running(); }
+
+    int getPlayerHP() const { return engine_.get_player_hp(); }
+    int getPlayerMaxHP() const { return engine_.get_player_max_hp(); }
 
     // Повертає HP ворога в поточній кімнаті (або 0, якщо ворога немає)
-    int getEnemyHP() const {
-        if (dungeon_ && current_room_id_ >= 0) {
-            auto* room = dungeon_->get_node_by_id(current_room_id_);
-            if (room && room->has_enemy()) {
-                return room->get_enemy()->get_hp();
-            }
-        }
-        return 0;
-    }
+    int getEnemyHP() const { return engine_.get_enemy_hp(); }
+
+    // Кількість переходів від поточної кімнати до виходу (-1, якщо шляху немає)
+    int getDistanceToExit() const { return engine_.get_distance_to_exit(); }
 
     // Повертає список назв сусідніх кімнат для кнопок навігації
     QVector<QString> getAvailableExits() const {
+        DUNGEON_ALLOC_SCOPE("Game::getAvailableExits");
         QVector<QString> exits;
-        if (!dungeon_) return exits;
+        GameMap* dungeon = engine_.get_map();
+        if (!dungeon) return exits;
 
-        auto neighbors = dungeon_->get_neighbors(current_room_id_);
-        for (auto* node : neighbors) {
+        const int room_id = engine_.get_current_room_id();
+        exits.reserve(static_cast<int>(dungeon->get_num_neighbors(room_id)));
+        dungeon->for_each_neighbor(room_id, [&exits](MapNode* node) {
             // Формуємо рядок типу "Кімната 2: Темний коридор"
             QString info = QString("Кімната %1: %2")
                 .arg(node->get_id())
-                .arg(QString::fromStdString(node->get_description()));
+                .arg(toQString(node->get_description()));
             exits.push_back(info);
-        }
+        });
         return exits;
     }
 
+    // Ядро гри (наприклад, для ботів або налагодження)
+    const GameEngine& engine() const { return engine_; }
+
 signals:
     // --- СИГНАЛИ (Game -> UI) ---
     // UI має підписатися на ці сигнали, щоб знати, що показувати
@@ -77,27 +75,15 @@ public slots:
      * @param classChoice Індекс з випадаючого списку (0-2)
      */
     void startNewGame(QString playerName, int classChoice) {
-        std::string name = playerName.toStdString();
-        if (name.empty()) name = "Герой";
-
-        // Створення гравця
+        DUNGEON_ALLOC_ACTION("Game::startNewGame");
+        DUNGEON_TRACE_SCOPE("Game::startNewGame");
+        PlayerClass player_class = PlayerClass::Warrior;
         switch (classChoice) {
-        case 0: player_ = std::make_unique<Warrior>(name); break;
-        case 1: player_ = std::make_unique<Mage>(name); break;
-        case 2: player_ = std::make_unique<Archer>(name); break;
-        default: player_ = std::make_unique<Warrior>(name);
+        case 1: player_class = PlayerClass::Mage; break;
+        case 2: player_class = PlayerClass::Archer; break;
+        default: break;
         }
-
-        generate_dungeon();
-        current_room_id_ = 0;
-        game_running_ = true;
-
-        emit gameStarted();
-        emit logMessage(QString("=== ЛАСКАВО ПРОСИМО, %1! ===").arg(playerName));
-        emit logMessage("Ви увійшли у підземелля. Знайдіть вихід!");
-
-        updateCurrentRoomInfo();
-        emit statsUpdated();
+        engine_.start(playerName.toStdString(), player_class);
     }
 
     /**
@@ -105,147 +91,124 @@ public slots:
      * @param exitIndex Індекс кнопки, яку натиснув гравець (0, 1, 2...)
      */
     void actionMove(int exitIndex) {
-        if (!game_running_) return;
-
-        // --- НОВА ЛОГІКА: БЛОКУВАННЯ ---
-        MapNode* currentRoom = dungeon_->get_node_by_id(current_room_id_);
-        if (currentRoom->has_enemy()) {
-            emit logMessage("⛔ Ви не можете вийти з кімнати під час бою! Переможіть ворога.");
-            return;
-        }
-        // -------------------------------
-
-        auto neighbors = dungeon_->get_neighbors(current_room_id_);
-
-        if (exitIndex >= 0 && exitIndex < static_cast<int>(neighbors.size())) {
-            current_room_id_ = neighbors[exitIndex]->get_id();
-            emit logMessage(QString("\n---> Ви перейшли до кімнати %1").arg(current_room_id_));
-            updateCurrentRoomInfo();
-            emit statsUpdated(); // Оновити UI
-        } else {
-            emit logMessage("Неможливо піти в цьому напрямку.");
-        }
+        DUNGEON_ALLOC_ACTION("Game::actionMove");
+        DUNGEON_TRACE_SCOPE("Game::actionMove");
+        engine_.move(exitIndex);
     }
 
     /**
      * @brief Виконання одного раунду бою
      */
     void actionAttack() {
-        if (!game_running_ || !player_) return;
-
-        MapNode* room = dungeon_->get_node_by_id(current_room_id_);
-        if (!room || !room->has_enemy()) {
-            emit logMessage("Тут немає кого атакувати.");
-            return;
-        }
-
-        Enemy* enemy = room->get_enemy();
-
-        // 1. Хід гравця
-        player_->attack(*enemy);
-        emit logMessage(QString("Ви атакували %1!").arg(QString::fromStdString(enemy->get_name())));
-
-        // 2. Перевірка смерті ворога
-        if (!enemy->is_alive()) {
-            emit logMessage(QString("🎉 ПЕРЕМОГА! %1 знищено.").arg(QString::fromStdString(enemy->get_name())));
-            room->clear_enemy();
-
-            // --- НОВА ЛОГІКА: ПЕРЕВІРКА ПОВНОЇ ЗАЧИСТКИ ---
-            if (dungeon_->allEnemiesDefeated()) {
-                emit logMessage("\n🏆 ВІТАЄМО! ПІДЗЕМЕЛЛЯ ЗАЧИЩЕНО!");
-                emit logMessage("Всі вороги знищені. Ви справжній герой!");
-                game_running_ = false;
-                emit gameOver(true);
-            } else {
-                emit logMessage("Підземелля стало трохи безпечнішим, але вороги ще залишилися...");
-            }
-            // ----------------------------------------------
-
-            updateCurrentRoomInfo();
-            emit statsUpdated();
-            return;
-        }
-
-        // 3. Хід ворога
-        enemy->attack(*player_);
-        emit logMessage(QString("⚠️ %1 атакує вас у відповідь!").arg(QString::fromStdString(enemy->get_name())));
-
-        // 4. Перевірка смерті гравця
-        if (!player_->is_alive()) {
-            emit logMessage("💀 ВАС ВБИТО! ГРА ЗАКІНЧЕНА.");
-            game_running_ = false;
-            emit gameOver(false);
-        }
-
-        emit statsUpdated();
+        DUNGEON_ALLOC_ACTION("Game::actionAttack");
+        DUNGEON_TRACE_SCOPE("Game::actionAttack");
+        engine_.attack();
     }
 
     /**
      * @brief Взаємодія з предметом у кімнаті
      */
     void actionTakeItem() {
-        if (!game_running_) return;
-
-        MapNode* room = dungeon_->get_node_by_id(current_room_id_);
-        if (room && room->has_item()) {
-            Item* item = room->get_item();
-            player_->add_item(item); // Додаємо в інвентар
-            emit logMessage(QString("Ви підібрали предмет: %1").arg(QString::fromStdString(item->get_name())));
-
-            room->clear_item();
-            updateCurrentRoomInfo();
-            emit statsUpdated();
-        }
+        DUNGEON_ALLOC_ACTION("Game::actionTakeItem");
+        DUNGEON_TRACE_SCOPE("Game::actionTakeItem");
+        engine_.take_item();
     }
 
     /**
      * @brief Перевірка умови перемоги (вихід з підземелля)
      */
     void actionExitDungeon() {
-        if (current_room_id_ == final_room_id_) {
-            emit logMessage("🚪 ВИ ЗНАЙШЛИ ВИХІД! ПЕРЕМОГА!");
-            game_running_ = false;
-            emit gameOver(true);
-        }
+        DUNGEON_ALLOC_ACTION("Game::actionExitDungeon");
+        DUNGEON_TRACE_SCOPE("Game::actionExitDungeon");
+        engine_.exit_dungeon();
     }
 
 private:
-    std::unique_ptr<GameMap> dungeon_;
-    std::unique_ptr<Player> player_;
-    int current_room_id_;
-    bool game_running_;
-    int final_room_id_;
-
-    // Допоміжний метод для генерації
-    void generate_dungeon() {
-        int num_rooms = 8 + (std::rand() % 5);
-        int num_enemies = num_rooms / 2;
-        int num_items = num_rooms / 2 + 1;
-
-        dungeon_ = std::make_unique<GameMap>();
-        dungeon_->generate_map(num_rooms, num_enemies, num_items);
-        final_room_id_ = num_rooms - 1;
+    // Журнал бою (engine_.get_combat_log()) у лог UI не виводиться, як і раніше
+    // результати attack; текст подій формується лише на вимогу через render
+    GameEngine engine_;
+
+    static QString toQString(std::string_view text) {
+        return QString::fromUtf8(text.data(), static_cast<int>(text.size()));
+    }
+
+    // Події ядра -> сигнали й повідомлення для UI
+    void on_game_event(const GameEvent& event) override {
+        switch (event.type) {
+        case GameEventType::GameStarted:
+            emit gameStarted();
+            emit logMessage(QString("=== ЛАСКАВО ПРОСИМО, %1! ===").arg(toQString(engine_.get_player()->get_name())));
+            emit logMessage("Ви увійшли у підземелля. Знайдіть вихід!");
+            break;
+        case GameEventType::RoomChanged:
+            updateCurrentRoomInfo();
+            break;
+        case GameEventType::StatsChanged:
+            emit statsUpdated();
+            break;
+        case GameEventType::MoveBlocked:
+            emit logMessage("⛔ Ви не можете вийти з кімнати під час бою! Переможіть ворога.");
+            break;
+        case GameEventType::Moved:
+            emit logMessage(QString("\n---> Ви перейшли до кімнати %1").arg(event.room_id));
+            break;
+        case GameEventType::MoveInvalid:
+            emit logMessage("Неможливо піти в цьому напрямку.");
+            break;
+        case GameEventType::NothingToAttack:
+            emit logMessage("Тут немає кого атакувати.");
+            break;
+        case GameEventType::PlayerAttacked:
+            emit logMessage(QString("Ви атакували %1!").arg(toQString(event.enemy->get_name())));
+            break;
+        case GameEventType::EnemyDefeated:
+            emit logMessage(QString("🎉 ПЕРЕМОГА! %1 знищено.").arg(toQString(event.enemy->get_name())));
+            break;
+        case GameEventType::DungeonCleared:
+            emit logMessage("\n🏆 ВІТАЄМО! ПІДЗЕМЕЛЛЯ ЗАЧИЩЕНО!");
+            emit logMessage("Всі вороги знищені. Ви справжній герой!");
+            break;
+        case GameEventType::EnemiesRemain:
+            emit logMessage("Підземелля стало трохи безпечнішим, але вороги ще залишилися...");
+            break;
+        case GameEventType::EnemyAttacked:
+            emit logMessage(QString("⚠️ %1 атакує вас у відповідь!").arg(toQString(event.enemy->get_name())));
+            break;
+        case GameEventType::PlayerDied:
+            emit logMessage("💀 ВАС ВБИТО! ГРА ЗАКІНЧЕНА.");
+            break;
+        case GameEventType::ItemTaken:
+            emit logMessage(QString("Ви підібрали предмет: %1").arg(toQString(event.item->get_name())));
+            break;
+        case GameEventType::ExitFound:
+            emit logMessage("🚪 ВИ ЗНАЙШЛИ ВИХІД! ПЕРЕМОГА!");
+            break;
+        case GameEventType::GameOver:
+            emit gameOver(event.victory);
+            break;
+        }
     }
 
     // Відправляє сигнали про стан поточної кімнати
     void updateCurrentRoomInfo() {
-        if (!dungeon_) return;
+        DUNGEON_ALLOC_SCOPE("Game::updateCurrentRoomInfo");
+        MapNode* room = engine_.get_current_room();
+        if (!room) return;
 
-        MapNode* room = dungeon_->get_node_by_id(current_room_id_);
-        QString desc = QString::fromStdString(room->get_description());
+        QString desc = toQString(room->get_description());
 
         // Додаємо деталі до опису
-        if (current_room_id_ == final_room_id_) {
+        if (engine_.get_current_room_id() == engine_.get_final_room_id()) {
             desc += "\n\n🚪 ТУТ Є ВИХІД З ПІДЗЕМЕЛЛЯ!";
         }
         if (room->has_enemy()) {
             desc += QString("\n\n👹 ТУТ ВОРОГ: %1 (HP: %2)")
-                .arg(QString::fromStdString(room->get_enemy()->get_name()))
-                .arg(room->get_enemy()->get_hp());
+                .arg(toQString(engine_.get_current_enemy()->get_name()))
+                .arg(engine_.get_current_enemy()->get_hp());
         }
         if (room->has_item()) {
             desc += QString("\n\n💎 ТУТ ПРЕДМЕТ: %1")
-                .arg(QString::fromStdString(room->get_item()->get_name()));
+                .arg(toQString(engine_.get_current_item()->get_name()));
         }
 
         emit roomUpdated(desc, room->has_enemy(), room->has_item());
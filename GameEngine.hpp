@@ -0,0 +1,302 @@
+#ifndef GAMEENGINE_HPP
+#define GAMEENGINE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AllocTracker.hpp"
+#include "GameMap.hpp"
+#include "CombatLog.hpp"
+#include "Random.hpp"
+#include "Trace.hpp"
+#include "Player.hpp"
+#include "Warrior.hpp"
+#include "Mage.hpp"
+#include "Archer.hpp"
+#include "Enemy.hpp"
+#include "Item.hpp"
+
+// Ігрове ядро без Qt: правила, стан і події гри.
+// Game (Qt) — лише тонкий адаптер, що перетворює події на сигнали й рядки,
+// тому пакетна симуляція працює без циклу подій і без форматування тексту.
+
+enum class PlayerClass {
+    Warrior,
+    Mage,
+    Archer
+};
+
+enum class GameEventType {
+    GameStarted,      // Гра почалася
+    RoomChanged,      // Змінився стан поточної кімнати (або гравець перейшов в іншу)
+    StatsChanged,     // Змінилися HP / стати
+    MoveBlocked,      // Спроба вийти з кімнати під час бою
+    Moved,            // Перехід до кімнати room_id
+    MoveInvalid,      // Такого виходу немає
+    NothingToAttack,
+    PlayerAttacked,   // Гравець атакував enemy
+    EnemyDefeated,    // enemy загинув
+    DungeonCleared,   // Усі вороги знищені
+    EnemiesRemain,    // Ворог загинув, але в підземеллі ще є інші
+    EnemyAttacked,    // enemy атакував гравця у відповідь
+    PlayerDied,
+    ItemTaken,        // Гравець підібрав item
+    ExitFound,        // Гравець вийшов з підземелля
+    GameOver          // Кінець гри (victory)
+};
+
+// Подія доставляється синхронно, тож вказівники дійсні під час обробки
+struct GameEvent {
+    GameEventType type;
+    int room_id = -1;
+    const Enemy* enemy = nullptr;
+    const Item* item = nullptr;
+    bool victory = false;
+};
+
+class GameEventListener {
+public:
+    virtual ~GameEventListener() = default;
+    virtual void on_game_event(const GameEvent& event) = 0;
+};
+
+class GameEngine {
+    friend struct SnapshotAccess; // Збереження й завантаження гри (Snapshot.hpp)
+
+private:
+    std::unique_ptr<GameMap> dungeon_;
+    std::unique_ptr<Player> player_;
+    int current_room_id_ = 0;
+    bool game_running_ = false;
+    int final_room_id_ = 0;
+    GameEventListener* listener_ = nullptr; // Non-owning
+    Rng rng_;            // Усі кидки гри: генерація карти, предмети, вороги, бій
+    uint64_t seed_ = 0;
+    CombatLog combat_log_; // Структуровані події бою; текст формує UI за потреби
+
+    void notify(GameEventType type, const Enemy* enemy = nullptr, const Item* item = nullptr) {
+        if (!listener_) return;
+        GameEvent event;
+        event.type = type;
+        event.room_id = current_room_id_;
+        event.enemy = enemy;
+        event.item = item;
+        listener_->on_game_event(event);
+    }
+
+    void finish(bool victory) {
+        game_running_ = false;
+        if (!listener_) return;
+        GameEvent event;
+        event.type = GameEventType::GameOver;
+        event.room_id = current_room_id_;
+        event.victory = victory;
+        listener_->on_game_event(event);
+    }
+
+    // Допоміжний метод для генерації
+    void generate_dungeon() {
+        DUNGEON_TRACE_SCOPE("GameEngine::generate_dungeon");
+        int num_rooms = 8 + static_cast<int>(rng_.below(5));
+        int num_enemies = num_rooms / 2;
+        int num_items = num_rooms / 2 + 1;
+
+        // Карта в купі: арена (GameMap(arena)) на карті з 8..12 кімнат не виграє
+        // нічого — див. dungeon_bench map-arena
+        dungeon_ = std::make_unique<GameMap>();
+        dungeon_->generate_map(num_rooms, num_enemies, num_items, rng_);
+        final_room_id_ = num_rooms - 1;
+    }
+
+public:
+    GameEngine() = default;
+
+    // Гравець (Archer) тримає вказівник на rng_, тож ядро не копіюється й не переміщується
+    GameEngine(const GameEngine&) = delete;
+    GameEngine& operator=(const GameEngine&) = delete;
+
+    // Слухач подій (може бути nullptr — тоді події просто не надсилаються)
+    void set_listener(GameEventListener* listener) { listener_ = listener; }
+
+    // Нова гра з випадковим зерном
+    void start(const std::string& player_name, PlayerClass player_class) {
+        start(player_name, player_class, Rng::random_seed());
+    }
+
+    // Нова гра з заданим зерном: ті самі зерно й дії відтворюють забіг біт-у-біт
+    void start(const std::string& player_name, PlayerClass player_class, uint64_t seed) {
+        DUNGEON_ALLOC_SCOPE("GameEngine::start");
+        seed_ = seed;
+        rng_.reseed(seed);
+        combat_log_.clear();
+
+        std::string name = player_name.empty() ? "Герой" : player_name;
+
+        // Створення гравця
+        switch (player_class) {
+        case PlayerClass::Warrior: player_ = std::make_unique<Warrior>(name); break;
+        case PlayerClass::Mage: player_ = std::make_unique<Mage>(name); break;
+        case PlayerClass::Archer: player_ = std::make_unique<Archer>(name, &rng_); break;
+        default: player_ = std::make_unique<Warrior>(name);
+        }
+        player_->attach_combat_log(&combat_log_);
+
+        generate_dungeon();
+        current_room_id_ = 0;
+        game_running_ = true;
+
+        notify(GameEventType::GameStarted);
+        notify(GameEventType::RoomChanged);
+        notify(GameEventType::StatsChanged);
+    }
+
+    // Перехід через вихід exit_index; false, якщо перейти не вдалося
+    bool move(int exit_index) {
+        DUNGEON_ALLOC_SCOPE("GameEngine::move");
+        if (!game_running_) return false;
+
+        // Блокування: з кімнати з ворогом вийти не можна
+        MapNode* current_room = dungeon_->get_node_by_id(current_room_id_);
+        if (current_room->has_enemy()) {
+            notify(GameEventType::MoveBlocked);
+            return false;
+        }
+
+        MapNode* next = exit_index >= 0
+            ? dungeon_->get_neighbor(current_room_id_, static_cast<size_t>(exit_index))
+            : nullptr;
+        if (!next) {
+            notify(GameEventType::MoveInvalid);
+            return false;
+        }
+
+        current_room_id_ = static_cast<int>(next->get_id());
+        notify(GameEventType::Moved);
+        notify(GameEventType::RoomChanged);
+        notify(GameEventType::StatsChanged);
+        return true;
+    }
+
+    // Один раунд бою; false, якщо атакувати нікого
+    bool attack() {
+        DUNGEON_ALLOC_SCOPE("GameEngine::attack");
+        if (!game_running_ || !player_) return false;
+
+        MapNode* room = dungeon_->get_node_by_id(current_room_id_);
+        if (!room || !room->has_enemy()) {
+            notify(GameEventType::NothingToAttack);
+            return false;
+        }
+
+        Enemy* enemy = dungeon_->get_enemy(*room);
+        enemy->attach_combat_log(&combat_log_);
+
+        // 1. Хід гравця
+        player_->attack(*enemy);
+        notify(GameEventType::PlayerAttacked, enemy);
+
+        // 2. Перевірка смерті ворога
+        if (!enemy->is_alive()) {
+            notify(GameEventType::EnemyDefeated, enemy);
+            dungeon_->remove_enemy(*room);
+
+            // Перевірка повної зачистки
+            if (dungeon_->allEnemiesDefeated()) {
+                notify(GameEventType::DungeonCleared);
+                finish(true);
+            } else {
+                notify(GameEventType::EnemiesRemain);
+            }
+
+            notify(GameEventType::RoomChanged);
+            notify(GameEventType::StatsChanged);
+            return true;
+        }
+
+        // 3. Хід ворога
+        enemy->attack(*player_);
+        notify(GameEventType::EnemyAttacked, enemy);
+
+        // 4. Перевірка смерті гравця
+        if (!player_->is_alive()) {
+            notify(GameEventType::PlayerDied);
+            finish(false);
+        }
+
+        notify(GameEventType::StatsChanged);
+        return true;
+    }
+
+    // Підняти предмет у поточній кімнаті; false, якщо предмета немає
+    bool take_item() {
+        DUNGEON_ALLOC_SCOPE("GameEngine::take_item");
+        if (!game_running_) return false;
+
+        MapNode* room = dungeon_->get_node_by_id(current_room_id_);
+        if (!room || !room->has_item()) return false;
+
+        Item* item = dungeon_->get_item(*room);
+        player_->add_item(item); // Додаємо в інвентар
+        notify(GameEventType::ItemTaken, nullptr, item);
+
+        dungeon_->remove_item(*room);
+        notify(GameEventType::RoomChanged);
+        notify(GameEventType::StatsChanged);
+        return true;
+    }
+
+    // Перевірка умови перемоги (вихід з підземелля)
+    bool exit_dungeon() {
+        if (current_room_id_ != final_room_id_) return false;
+
+        notify(GameEventType::ExitFound);
+        finish(true);
+        return true;
+    }
+
+    // --- СТАН ---
+
+    bool is_running() const { return game_running_; }
+    uint64_t get_seed() const { return seed_; }
+    int get_current_room_id() const { return current_room_id_; }
+    int get_final_room_id() const { return final_room_id_; }
+
+    GameMap* get_map() const { return dungeon_.get(); }
+    const CombatLog& get_combat_log() const { return combat_log_; }
+    Player* get_player() const { return player_.get(); }
+
+    MapNode* get_current_room() const {
+        return dungeon_ ? dungeon_->get_node_by_id(current_room_id_) : nullptr;
+    }
+
+    // Ворог / предмет у поточній кімнаті (nullptr, якщо немає)
+    Enemy* get_current_enemy() const {
+        MapNode* room = get_current_room();
+        return room ? dungeon_->get_enemy(*room) : nullptr;
+    }
+
+    Item* get_current_item() const {
+        MapNode* room = get_current_room();
+        return room ? dungeon_->get_item(*room) : nullptr;
+    }
+
+    int get_player_hp() const { return player_ ? player_->get_hp() : 0; }
+    int get_player_max_hp() const { return player_ ? player_->get_max_hp() : 100; }
+
+    // HP ворога в поточній кімнаті (або 0, якщо ворога немає)
+    int get_enemy_hp() const {
+        Enemy* enemy = get_current_enemy();
+        return enemy ? enemy->get_hp() : 0;
+    }
+
+    // Кількість переходів від поточної кімнати до виходу (-1, якщо шляху немає)
+    int get_distance_to_exit() const {
+        if (!dungeon_) return -1;
+        return dungeon_->get_distance(current_room_id_, final_room_id_);
+    }
+};
+
+#endif // GAMEENGINE_HPP
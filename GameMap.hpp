@@ -1,7 +1,11 @@
 #ifndef GAMEMAP_HPP
 #define GAMEMAP_HPP
 
+#include "AllocTracker.hpp"
+#include "Arena.hpp"
+#include "Trace.hpp"
 #include "Graph.hpp"
+#include "DistanceField.hpp"
 #include "MapNode.hpp"
 #include "Enemy.hpp"
 #include "Goblin.hpp"
@@ -11,129 +15,216 @@
 #include "Weapon.hpp"
 #include "Armor.hpp"
 #include "Potion.hpp"
+#include "Random.hpp"
+#include "Parallel.hpp"
+#include <array>
 #include <vector>
 #include <memory>
-#include <cstdlib>
-#include <ctime>
+#include <memory_resource>
 #include <algorithm>
-#include <random>
-#include <sstream>
 #include <string>
+#include <optional>
+#include <utility>
+#include <unordered_map>
 
 class GameMap {
+    friend struct SnapshotAccess; // Знімок карти (Snapshot.hpp)
+
 private:
-    Graph<MapNode*> graph_;
-    std::vector<std::unique_ptr<MapNode>> nodes_;
-    std::vector<std::unique_ptr<Enemy>> enemies_;
-    std::vector<std::unique_ptr<Item>> items_;
+    // Арена для кімнат, ворогів і предметів (nullptr — звичайна купа).
+    // Non-owning: власник арени скидає її лише після знищення карти.
+    std::pmr::memory_resource* arena_ = nullptr;
 
-    static bool random_initialized_;
+    // Граф ключується id кімнати напряму: хеш і CSR-індекс — це саме число,
+    // без розіменування вузла. Кімнати лежать за значенням, nodes_[id].
+    Graph<uint32_t> graph_;
+    std::pmr::vector<MapNode> nodes_;
+    std::pmr::vector<arena_ptr<Enemy>> enemies_;
+    std::pmr::vector<arena_ptr<Item>> items_;
 
-    void init_random() {
-        if (!random_initialized_) {
-            std::srand(static_cast<unsigned>(std::time(nullptr)));
-            random_initialized_ = true;
-        }
+    // Вороги, що стоять у кімнатах: усього й за типом (CombatKind).
+    // Оновлюються при розміщенні й remove_enemy, тож перевірка перемоги — O(1).
+    uint32_t live_enemies_ = 0;
+    std::array<uint32_t, combat_kind_count> live_by_kind_{};
+
+    // Кеш полів відстаней: id цільової кімнати -> відстані до неї з усіх кімнат.
+    // Оновлюються інкрементально в add_corridor.
+    std::unordered_map<int, DistanceField> distance_fields_;
+
+    // Кімната зберігає лише індекси в names::room_types / room_features
+    MapNode create_room(uint32_t id, Rng& rng) {
+        auto type_idx = static_cast<uint8_t>(rng.below(static_cast<uint32_t>(names::room_types.size())));
+        auto feature_idx = static_cast<uint8_t>(rng.below(static_cast<uint32_t>(names::room_features.size())));
+        return MapNode(id, type_idx, feature_idx);
+    }
+
+    bool valid_id(int id) const {
+        return id >= 0 && id < static_cast<int>(nodes_.size());
     }
 
-    std::string generate_room_description(int /* id */) {
-        const std::vector<std::string> room_types = {
-            "Темний коридор", "Стародавня зала", "Затхле підземелля",
-            "Кам'яний прохід", "Освітлений факелами прохід", "Занедбаний склеп",
-            "Таємнича скарбниця", "Тінява ніша", "Зруйнована крипта", "Підземна печера"
-        };
+    void reset(int num_rooms, int num_enemies, int num_items) {
+        nodes_.clear();
+        enemies_.clear();
+        items_.clear();
+        graph_.clear();
+        distance_fields_.clear();
+        live_enemies_ = 0;
+        live_by_kind_.fill(0);
+
+        // В арені звільнена пам'ять не перевикористовується, тож без зайвих перевиділень
+        nodes_.reserve(static_cast<size_t>(std::max(num_rooms, 0)));
+        enemies_.reserve(static_cast<size_t>(std::max(std::min(num_enemies, num_rooms), 0)));
+        items_.reserve(static_cast<size_t>(std::max(std::min(num_items, num_rooms), 0)));
+    }
 
-        const std::vector<std::string> features = {
-            "вкрита павутинням", "з якої крапає вода", "зі смородом гнилі",
-            "що відлунює шепотами", "вкрита мохом", "сповнена туману",
-            "обкладена кістками", "вирізьблена рунами", "тьмяно освітлена", "моторошно тиха"
-        };
+    // Незалежні потоки випадковості паралельної генерації (Rng::stream_seed)
+    enum GenerationStream : uint64_t {
+        room_stream = 1,
+        edge_stream,
+        enemy_slot_stream,
+        enemy_stream,
+        item_slot_stream,
+        item_stream
+    };
 
-        int type_idx = std::rand() % room_types.size();
-        int feature_idx = std::rand() % features.size();
+    // count кімнат з найменшими випадковими ключами (key, id) — рівномірна випадкова
+    // вибірка без тасування. Повертає прапорці вибраних кімнат.
+    std::vector<uint8_t> pick_rooms(size_t count, uint64_t seed, GenerationStream stream, unsigned num_threads) const {
+        const size_t rooms = nodes_.size();
+        std::vector<uint8_t> picked(rooms, 0);
+        if (count == 0) return picked;
 
-        return room_types[type_idx] + " " + features[feature_idx];
+        std::vector<std::pair<uint64_t, uint32_t>> keys(rooms);
+        parallel_for(rooms, num_threads, [&](size_t begin, size_t end, unsigned) {
+            for (size_t id = begin; id < end; ++id) {
+                keys[id] = { Rng::stream_seed(seed, stream, id), static_cast<uint32_t>(id) };
+            }
+        });
+        if (count < rooms) {
+            std::nth_element(keys.begin(), keys.begin() + static_cast<std::ptrdiff_t>(count), keys.end());
+        }
+        for (size_t i = 0; i < std::min(count, rooms); ++i) {
+            picked[keys[i].second] = 1;
+        }
+        return picked;
     }
 
-    std::unique_ptr<Enemy> create_random_enemy() {
-        int type = std::rand() % 3;
-        switch (type) {
-        case 0: return std::make_unique<Goblin>("Гоблін");
-        case 1: return std::make_unique<Orc>("Орк");
-        case 2: return std::make_unique<Wraith>("Примара");
-        default: return std::make_unique<Goblin>("Гоблін");
+    // Ворог заданого типу з базовими статами (Goblin / Orc / Wraith)
+    arena_ptr<Enemy> make_enemy(CombatKind kind) {
+        switch (kind) {
+        case CombatKind::Orc: return make_arena<Orc>(arena_, "Орк");
+        case CombatKind::Wraith: return make_arena<Wraith>(arena_, "Примара");
+        default: return make_arena<Goblin>(arena_, "Гоблін");
         }
     }
 
-    std::unique_ptr<Item> create_random_item() {
-        int type = std::rand() % 3;
+    // Предмет за видом і індексом назви в names::*_names
+    arena_ptr<Item> make_item(ItemKind kind, size_t name_idx, int value) {
+        switch (kind) {
+        case ItemKind::Weapon:
+            return make_arena<Weapon>(arena_, names::weapon_names[name_idx], names::weapon_description, value);
+        case ItemKind::Armor:
+            return make_arena<Armor>(arena_, names::armor_names[name_idx], names::armor_description, value);
+        default:
+            return make_arena<Potion>(arena_, names::potion_names[name_idx], names::potion_description, value);
+        }
+    }
 
-        const std::vector<std::string> weapon_names = { "Іржавий меч", "Залізна сокира", "Стальний кинджал", "Стародавня булава", "Ельфійський лук" };
-        const std::vector<std::string> armor_names = { "Шкіряний жилет", "Кольчуга", "Залізний щит", "Латний обладунок", "Магічний плащ" };
-        const std::vector<std::string> potion_names = { "Зілля здоров'я", "Еліксир", "Цілющий настій", "Фляга відновлення", "Есенція життя" };
+    arena_ptr<Enemy> create_random_enemy(Rng& rng) {
+        static constexpr CombatKind kinds[] = { CombatKind::Goblin, CombatKind::Orc, CombatKind::Wraith };
+        return make_enemy(kinds[rng.below(3)]);
+    }
 
-        switch (type) {
+    arena_ptr<Item> create_random_item(Rng& rng) {
+        switch (rng.below(3)) {
         case 0: {
-            int idx = std::rand() % weapon_names.size();
-            int damage = 15 + std::rand() % 25;
-            return std::make_unique<Weapon>(weapon_names[idx], "Надійна зброя", damage);
+            size_t idx = rng.below(static_cast<uint32_t>(names::weapon_names.size()));
+            return make_item(ItemKind::Weapon, idx, 15 + static_cast<int>(rng.below(25)));
         }
         case 1: {
-            int idx = std::rand() % armor_names.size();
-            int defense = 10 + std::rand() % 20;
-            return std::make_unique<Armor>(armor_names[idx], "Захисне спорядження", defense);
+            size_t idx = rng.below(static_cast<uint32_t>(names::armor_names.size()));
+            return make_item(ItemKind::Armor, idx, 10 + static_cast<int>(rng.below(20)));
         }
-        case 2: {
-            int idx = std::rand() % potion_names.size();
-            int heal = 20 + std::rand() % 40;
-            return std::make_unique<Potion>(potion_names[idx], "Відновлює здоров'я", heal);
+        default: {
+            size_t idx = rng.below(static_cast<uint32_t>(names::potion_names.size()));
+            return make_item(ItemKind::Potion, idx, 20 + static_cast<int>(rng.below(40)));
         }
-        default: return std::make_unique<Potion>("Зілля здоров'я", "Відновлює здоров'я", 30);
         }
     }
 
 public:
-    GameMap() { init_random(); }
+    GameMap() = default;
+
+    // Карта в арені: усі кімнати, вороги, предмети й описи беруться з arena.
+    // Арена має пережити карту; скидати її (release) можна лише після знищення карти.
+    explicit GameMap(std::pmr::memory_resource* arena)
+        : arena_(arena),
+        nodes_(arena ? arena : std::pmr::get_default_resource()),
+        enemies_(arena ? arena : std::pmr::get_default_resource()),
+        items_(arena ? arena : std::pmr::get_default_resource()) {
+    }
+
     ~GameMap() = default;
 
-    // Перевіряє, чи всі вороги мертві (або їх взагалі не лишилося)
+    GameMap(const GameMap&) = delete;
+    GameMap& operator=(const GameMap&) = delete;
+
+    bool uses_arena() const { return arena_ != nullptr; }
+
+    // Перевіряє, чи всі вороги переможені (або їх взагалі не було), O(1)
     bool allEnemiesDefeated() const {
-        for (const auto& node : nodes_) {
-            if (node->has_enemy()) {
-                if (node->get_enemy()->is_alive()) {
-                    return false; // Знайшли живого ворога -> гра ще не виграна
-                }
-            }
-        }
-        return true; // Нікого не знайшли -> перемога
+        return live_enemies_ == 0;
+    }
+
+    uint32_t get_live_enemy_count() const { return live_enemies_; }
+
+    uint32_t get_live_enemy_count(CombatKind kind) const {
+        return live_by_kind_[static_cast<size_t>(kind)];
     }
 
+    // Прибирає ворога з кімнати (переможеного) і оновлює лічильники
+    void remove_enemy(MapNode& room) {
+        Enemy* enemy = get_enemy(room);
+        if (!enemy) return;
+        --live_enemies_;
+        --live_by_kind_[static_cast<size_t>(enemy->get_combat_kind())];
+        room.clear_enemy();
+    }
+
+    // Прибирає предмет з кімнати (підібраний); сам об'єкт лишається в карті
+    void remove_item(MapNode& room) {
+        room.clear_item();
+    }
+
+    // Генерація з випадковим зерном (коли відтворюваність не потрібна)
     void generate_map(int num_rooms, int num_enemies, int num_items) {
-        nodes_.clear();
-        enemies_.clear();
-        items_.clear();
-        // Graph очищується автоматично при перестворенні, або треба додати метод clear() у Graph.hpp
-        // Припустимо, що Graph очищується сам або ми створюємо новий об'єкт
+        Rng rng(Rng::random_seed());
+        generate_map(num_rooms, num_enemies, num_items, rng);
+    }
+
+    // Детермінована генерація: однаковий стан rng -> однакова карта
+    void generate_map(int num_rooms, int num_enemies, int num_items, Rng& rng) {
+        DUNGEON_ALLOC_SCOPE("GameMap::generate_map");
+        DUNGEON_TRACE_SCOPE("GameMap::generate_map");
+        reset(num_rooms, num_enemies, num_items);
 
         for (int i = 0; i < num_rooms; ++i) {
-            std::string desc = generate_room_description(i);
-            auto node = std::make_unique<MapNode>(i, desc);
-            graph_.add_node(node.get());
-            nodes_.push_back(std::move(node));
+            nodes_.push_back(create_room(static_cast<uint32_t>(i), rng));
+            graph_.add_node(static_cast<uint32_t>(i));
         }
 
         // Лінійний шлях
         for (int i = 0; i < num_rooms - 1; ++i) {
-            graph_.add_undirected_edge(nodes_[i].get(), nodes_[i + 1].get());
+            graph_.add_undirected_edge(static_cast<uint32_t>(i), static_cast<uint32_t>(i + 1));
         }
 
         // Випадкові з'єднання
         int extra_connections = num_rooms / 2;
         for (int i = 0; i < extra_connections; ++i) {
-            int from = std::rand() % num_rooms;
-            int to = std::rand() % num_rooms;
-            if (from != to && !graph_.has_edge(nodes_[from].get(), nodes_[to].get())) {
-                graph_.add_undirected_edge(nodes_[from].get(), nodes_[to].get());
+            uint32_t from = rng.below(static_cast<uint32_t>(num_rooms));
+            uint32_t to = rng.below(static_cast<uint32_t>(num_rooms));
+            if (from != to && !graph_.has_edge(from, to)) {
+                graph_.add_undirected_edge(from, to);
             }
         }
 
@@ -141,36 +232,216 @@ public:
         std::vector<int> available_rooms(num_rooms);
         for (int i = 0; i < num_rooms; ++i) available_rooms[i] = i;
 
-        std::random_device rd;
-        std::mt19937 g(rd());
-        std::shuffle(available_rooms.begin(), available_rooms.end(), g);
+        shuffle_with(available_rooms, rng);
 
         for (int i = 0; i < num_enemies && i < num_rooms; ++i) {
-            auto enemy = create_random_enemy();
-            nodes_[available_rooms[i]]->set_enemy(enemy.get());
-            enemies_.push_back(std::move(enemy));
+            nodes_[available_rooms[i]].set_enemy_index(static_cast<uint32_t>(enemies_.size()));
+            enemies_.push_back(create_random_enemy(rng));
+            ++live_enemies_;
+            ++live_by_kind_[static_cast<size_t>(enemies_.back()->get_combat_kind())];
         }
 
-        std::shuffle(available_rooms.begin(), available_rooms.end(), g);
+        shuffle_with(available_rooms, rng);
 
         for (int i = 0; i < num_items && i < num_rooms; ++i) {
-            auto item = create_random_item();
-            nodes_[available_rooms[i]]->set_item(item.get());
-            items_.push_back(std::move(item));
+            nodes_[available_rooms[i]].set_item_index(static_cast<uint32_t>(items_.size()));
+            items_.push_back(create_random_item(rng));
         }
+
+        // Генерацію завершено: заморожуємо граф у компактний CSR для швидких обходів
+        graph_.compact();
     }
 
-    MapNode* get_node_by_id(int id) {
-        if (id >= 0 && id < static_cast<int>(nodes_.size())) {
-            return nodes_[id].get();
+    // Паралельна детермінована генерація для великих карт. Кімнати, ребра й
+    // розміщення ворогів і предметів діляться між потоками; кожен елемент має
+    // власний Rng(Rng::stream_seed(seed, потік, індекс)), тож той самий seed дає
+    // ту саму карту за будь-якої кількості потоків. Структура та сама, що в
+    // generate_map, але карта інша, ніж generate_map з Rng(seed).
+    // Об'єкти ворогів і предметів в арені створюються послідовно (арена однопотокова).
+    void generate_map_parallel(int num_rooms, int num_enemies, int num_items, uint64_t seed,
+                               unsigned num_threads = 0) {
+        DUNGEON_ALLOC_SCOPE("GameMap::generate_map_parallel");
+        DUNGEON_TRACE_SCOPE("GameMap::generate_map_parallel");
+        num_threads = resolve_thread_count(num_threads);
+        reset(num_rooms, num_enemies, num_items);
+        const size_t rooms = static_cast<size_t>(std::max(num_rooms, 0));
+
+        // 1. Кімнати
+        nodes_.assign(rooms, MapNode(0, 0, 0));
+        parallel_for(rooms, num_threads, [&](size_t begin, size_t end, unsigned) {
+            for (size_t id = begin; id < end; ++id) {
+                Rng rng(Rng::stream_seed(seed, room_stream, id));
+                nodes_[id] = create_room(static_cast<uint32_t>(id), rng);
+            }
+        });
+
+        // 2. Ребра: лінійний шлях + випадкові з'єднання (дублікати й петлі відкидає граф)
+        const size_t path_edges = rooms > 0 ? rooms - 1 : 0;
+        const size_t extra_connections = rooms / 2;
+        std::vector<std::pair<uint32_t, uint32_t>> edges(path_edges + extra_connections);
+        parallel_for(edges.size(), num_threads, [&](size_t begin, size_t end, unsigned) {
+            for (size_t k = begin; k < end; ++k) {
+                if (k < path_edges) {
+                    edges[k] = { static_cast<uint32_t>(k), static_cast<uint32_t>(k + 1) };
+                } else {
+                    Rng rng(Rng::stream_seed(seed, edge_stream, k - path_edges));
+                    uint32_t from = rng.below(static_cast<uint32_t>(rooms));
+                    uint32_t to = rng.below(static_cast<uint32_t>(rooms));
+                    edges[k] = { from, to };
+                }
+            }
+        });
+
+        std::vector<uint32_t> ids(rooms);
+        parallel_for(rooms, num_threads, [&](size_t begin, size_t end, unsigned) {
+            for (size_t id = begin; id < end; ++id) ids[id] = static_cast<uint32_t>(id);
+        });
+        graph_.assign_undirected(std::move(ids), edges, num_threads);
+
+        // 3. Вороги й предмети: вибір кімнат і створення об'єктів (тип — від id кімнати)
+        std::vector<uint8_t> enemy_rooms = pick_rooms(static_cast<size_t>(std::max(num_enemies, 0)),
+                                                      seed, enemy_slot_stream, num_threads);
+        std::vector<uint8_t> item_rooms = pick_rooms(static_cast<size_t>(std::max(num_items, 0)),
+                                                     seed, item_slot_stream, num_threads);
+
+        std::vector<uint32_t> enemy_room_ids;
+        std::vector<uint32_t> item_room_ids;
+        for (size_t id = 0; id < rooms; ++id) {
+            if (enemy_rooms[id]) {
+                nodes_[id].set_enemy_index(static_cast<uint32_t>(enemy_room_ids.size()));
+                enemy_room_ids.push_back(static_cast<uint32_t>(id));
+            }
+            if (item_rooms[id]) {
+                nodes_[id].set_item_index(static_cast<uint32_t>(item_room_ids.size()));
+                item_room_ids.push_back(static_cast<uint32_t>(id));
+            }
         }
-        return nullptr;
+
+        const unsigned object_threads = arena_ ? 1u : num_threads;
+        enemies_.resize(enemy_room_ids.size());
+        items_.resize(item_room_ids.size());
+        parallel_for(enemies_.size(), object_threads, [&](size_t begin, size_t end, unsigned) {
+            for (size_t i = begin; i < end; ++i) {
+                Rng rng(Rng::stream_seed(seed, enemy_stream, enemy_room_ids[i]));
+                enemies_[i] = create_random_enemy(rng);
+            }
+        });
+        parallel_for(items_.size(), object_threads, [&](size_t begin, size_t end, unsigned) {
+            for (size_t i = begin; i < end; ++i) {
+                Rng rng(Rng::stream_seed(seed, item_stream, item_room_ids[i]));
+                items_[i] = create_random_item(rng);
+            }
+        });
+
+        for (const auto& enemy : enemies_) {
+            ++live_enemies_;
+            ++live_by_kind_[static_cast<size_t>(enemy->get_combat_kind())];
+        }
+    }
+
+    MapNode* get_node_by_id(int id) {
+        return valid_id(id) ? &nodes_[id] : nullptr;
+    }
+
+    const MapNode* get_node_by_id(int id) const {
+        return valid_id(id) ? &nodes_[id] : nullptr;
+    }
+
+    // Ворог / предмет кімнати (nullptr, якщо немає)
+    Enemy* get_enemy(const MapNode& node) const {
+        return node.has_enemy() ? enemies_[node.get_enemy_index()].get() : nullptr;
+    }
+
+    Item* get_item(const MapNode& node) const {
+        return node.has_item() ? items_[node.get_item_index()].get() : nullptr;
     }
 
     std::vector<MapNode*> get_neighbors(int id) {
-        MapNode* node = get_node_by_id(id);
-        if (!node) return {};
-        return graph_.get_neighbors(node);
+        DUNGEON_ALLOC_SCOPE("GameMap::get_neighbors");
+        std::vector<MapNode*> neighbors;
+        for_each_neighbor(id, [&neighbors](MapNode* node) { neighbors.push_back(node); });
+        return neighbors;
+    }
+
+    // Обхід сусідніх кімнат без виділення пам'яті: fn(MapNode*)
+    template <typename Fn>
+    void for_each_neighbor(int id, Fn&& fn) {
+        if (!valid_id(id)) return;
+        graph_.for_each_neighbor(static_cast<uint32_t>(id), [this, &fn](uint32_t neighbor) {
+            fn(&nodes_[neighbor]);
+        });
+    }
+
+    size_t get_num_neighbors(int id) const {
+        if (!valid_id(id)) return 0;
+        return graph_.neighbor_count(static_cast<uint32_t>(id));
+    }
+
+    // Сусідня кімната за індексом виходу (nullptr, якщо такого виходу немає)
+    MapNode* get_neighbor(int id, size_t index) {
+        if (!valid_id(id)) return nullptr;
+        std::optional<uint32_t> neighbor = graph_.neighbor_at(static_cast<uint32_t>(id), index);
+        return neighbor ? &nodes_[*neighbor] : nullptr;
+    }
+
+    // Граф кімнат за id (компактний після generate_map) для пошуку шляхів
+    const Graph<uint32_t>& get_graph() const { return graph_; }
+
+    // Пам'ять під кімнати й граф (без ворогів і предметів), байт
+    size_t memory_bytes() const {
+        return nodes_.capacity() * sizeof(MapNode) + graph_.memory_bytes();
+    }
+
+    // Поле відстаней до кімнати room_id (будується при першому запиті й кешується)
+    const DistanceField* get_distance_field(int room_id) {
+        DUNGEON_ALLOC_SCOPE("GameMap::get_distance_field");
+        if (!valid_id(room_id)) return nullptr;
+
+        auto it = distance_fields_.find(room_id);
+        if (it == distance_fields_.end()) {
+            it = distance_fields_.emplace(room_id, DistanceField()).first;
+            it->second.build(graph_, std::vector<uint32_t>{ static_cast<uint32_t>(room_id) });
+        }
+        return &it->second;
+    }
+
+    // Кількість переходів між кімнатами, O(1) після першого запиту до to_id; -1, якщо шляху немає
+    int get_distance(int from_id, int to_id) {
+        const DistanceField* field = get_distance_field(to_id);
+        if (!field || !valid_id(from_id) || !field->is_reachable(from_id)) return -1;
+        return static_cast<int>(field->at(from_id));
+    }
+
+    // Multi-source поле: відстань від кожної кімнати до найближчої з source_ids
+    // (наприклад, до найближчого гравця). Не кешується — джерела змінюються.
+    DistanceField build_distance_field(const std::vector<int>& source_ids) const {
+        DUNGEON_ALLOC_SCOPE("GameMap::build_distance_field");
+        std::vector<uint32_t> sources;
+        sources.reserve(source_ids.size());
+        for (int id : source_ids) {
+            if (valid_id(id)) {
+                sources.push_back(static_cast<uint32_t>(id));
+            }
+        }
+        DistanceField field;
+        field.build(graph_, sources);
+        return field;
+    }
+
+    // Додає прохід між кімнатами після генерації: ребро вставляється в компактний
+    // граф на місці, а кешовані поля відстаней оновлюються інкрементально
+    void add_corridor(int from_id, int to_id) {
+        if (!valid_id(from_id) || !valid_id(to_id) || from_id == to_id) return;
+        const auto from = static_cast<uint32_t>(from_id);
+        const auto to = static_cast<uint32_t>(to_id);
+        if (graph_.has_edge(from, to)) return;
+
+        graph_.insert_undirected_edge(from, to);
+
+        for (auto& entry : distance_fields_) {
+            entry.second.on_edge_added(graph_, from, to);
+            entry.second.on_edge_added(graph_, to, from);
+        }
     }
 
     size_t get_num_rooms() const {
@@ -180,6 +451,4 @@ public:
     // get_path і інші методи можна залишити, якщо вони не використовують cout
 };
 
-inline bool GameMap::random_initialized_ = false;
-
 #endif // GAMEMAP_HPP
@@ -10,11 +10,14 @@ public:
         : Enemy(name, 40, 10, 3) {
     }
 
-    std::string attack(Character& target) override {
-        std::string damage_log = target.take_damage(attack_power_);
-        return "👺 " + name_ + " (Гоблін) швидко атакує! " + damage_log;
+    int attack(Character& target) override {
+        int dealt = target.take_damage(attack_power_);
+        record_event(CombatEventKind::QuickStrike, target, dealt);
+        return dealt;
     }
 
+    CombatKind get_combat_kind() const override { return CombatKind::Goblin; }
+
     std::string get_stats_string() const override {
         return Character::get_stats_string() + " (Гоблін: Слабкий ворог)";
     }
@@ -9,14 +9,375 @@
 #include <algorithm>
 #include <optional>
 #include <stdexcept>
+#include <cstdint>
+#include <limits>
+#include <iterator>
 
-// Graph  䳺  UI ,    .
-// ³   .
+#include "AllocTracker.hpp"
+#include "TraversalContext.hpp"
+#include "Parallel.hpp"
+
+// Graph не взаємодіє з UI напряму, тому тут змін мінімум.
+// Він просто зберігає дані.
+
+// Режим bfs: звичайний пошук від start або двонаправлений (зустріч посередині)
+enum class BfsMode {
+    Forward,
+    Bidirectional
+};
+
+// Щільний цілочисельний id вузла (0..size()-1) для компактного представлення.
+// За замовчуванням вузол сам є числом (так GameMap ключує граф id кімнат).
+template <typename T>
+struct graph_node_id {
+    size_t operator()(const T& data) const { return static_cast<size_t>(data); }
+};
 
 template <typename T>
 class Graph {
+public:
+    // Вага ребра (вартість проходу коридором). Для bfs/dfs ваги ігноруються.
+    using weight_type = graph_weight_t;
+
 private:
-    std::unordered_map<T, std::unordered_set<T>> adjacency_list;
+    // вузол -> (сусід -> вага ребра)
+    using neighbor_map = std::unordered_map<T, weight_type>;
+
+    std::unordered_map<T, neighbor_map> adjacency_list;
+
+    // Компактне (CSR) представлення, яке будує compact().
+    // Сусіди вузла з id i: csr_neighbors_[csr_offsets_[i] .. csr_offsets_[i + 1]),
+    // відсортовані за id; ваги ребер лежать паралельно в csr_weights_.
+    // Поки граф компактний, adjacency_list порожній.
+    static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+    bool compacted_ = false;
+    std::vector<T> csr_nodes_;
+    std::vector<uint32_t> csr_offsets_;
+    std::vector<uint32_t> csr_neighbors_;
+    std::vector<weight_type> csr_weights_;
+
+    // Вхідні ребра для зворотного боку двонаправленого bfs. Будуються лише
+    // для несиметричного графа; для неорієнтованого збігаються з csr_*.
+    bool csr_symmetric_ = true;
+    std::vector<uint32_t> csr_in_offsets_;
+    std::vector<uint32_t> csr_in_neighbors_;
+
+    uint32_t index_of(const T& data) const {
+        size_t id = graph_node_id<T>()(data);
+        if (id >= csr_nodes_.size() || !(csr_nodes_[id] == data)) {
+            return npos;
+        }
+        return static_cast<uint32_t>(id);
+    }
+
+    void check_mutable() const {
+        if (compacted_) {
+            throw std::runtime_error("Graph is compacted");
+        }
+    }
+
+    // Кожне ребро має зворотне. Списки сусідів відсортовані, тож джерела, що
+    // приходять у вузол при обході за зростанням id, мають іти рівно в порядку
+    // його власного списку: один прохід O(V + E) з курсором на вузол
+    static bool csr_is_symmetric(const std::vector<uint32_t>& offsets, const std::vector<uint32_t>& neighbors) {
+        const size_t n = offsets.size() - 1;
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t id = 0; id < n; ++id) {
+            for (uint32_t k = offsets[id]; k < offsets[id + 1]; ++k) {
+                const uint32_t to = neighbors[k];
+                if (cursor[to] == offsets[to + 1] || neighbors[cursor[to]] != id) return false;
+                ++cursor[to];
+            }
+        }
+        for (size_t id = 0; id < n; ++id) {
+            if (cursor[id] != offsets[id + 1]) return false;
+        }
+        return true;
+    }
+
+    // Встановлює готові CSR-масиви (сусіди кожного вузла відсортовані):
+    // визначає симетричність і за потреби будує вхідні ребра
+    void install_csr(std::vector<T> nodes, std::vector<uint32_t> offsets,
+                     std::vector<uint32_t> neighbors, std::vector<weight_type> weights) {
+        const size_t n = nodes.size();
+        const size_t num_edges = neighbors.size();
+        const bool symmetric = csr_is_symmetric(offsets, neighbors);
+
+        std::vector<uint32_t> in_offsets;
+        std::vector<uint32_t> in_neighbors;
+        if (!symmetric) {
+            in_offsets.assign(n + 1, 0);
+            for (uint32_t to : neighbors) {
+                ++in_offsets[to + 1];
+            }
+            for (size_t i = 0; i < n; ++i) {
+                in_offsets[i + 1] += in_offsets[i];
+            }
+            in_neighbors.resize(num_edges);
+            std::vector<uint32_t> fill(in_offsets.begin(), in_offsets.end() - 1);
+            for (size_t id = 0; id < n; ++id) {
+                for (uint32_t k = offsets[id]; k < offsets[id + 1]; ++k) {
+                    in_neighbors[fill[neighbors[k]]++] = static_cast<uint32_t>(id);
+                }
+            }
+        }
+
+        csr_nodes_ = std::move(nodes);
+        csr_offsets_ = std::move(offsets);
+        csr_neighbors_ = std::move(neighbors);
+        csr_weights_ = std::move(weights);
+        csr_symmetric_ = symmetric;
+        csr_in_offsets_ = std::move(in_offsets);
+        csr_in_neighbors_ = std::move(in_neighbors);
+        compacted_ = true;
+    }
+
+    void check_compact() const {
+        if (!compacted_) {
+            throw std::runtime_error("Graph is not compacted");
+        }
+    }
+
+    // Вставляє to у відсортований список сусідів from прямо в CSR-масивах: хвіст
+    // масивів зсувається на одну позицію, зсуви наступних вузлів — на одиницю.
+    // weights == nullptr — масив без ваг (вхідні ребра). Існуюче ребро лише
+    // отримує нову вагу; повертає, чи ребро нове.
+    static bool csr_insert(std::vector<uint32_t>& offsets, std::vector<uint32_t>& targets,
+                           std::vector<weight_type>* weights, uint32_t from, uint32_t to, weight_type weight) {
+        auto first = targets.begin() + offsets[from];
+        auto last = targets.begin() + offsets[from + 1];
+        auto pos = std::lower_bound(first, last, to);
+        const auto k = pos - targets.begin();
+        if (pos != last && *pos == to) {
+            if (weights) (*weights)[k] = weight;
+            return false;
+        }
+
+        targets.insert(pos, to);
+        if (weights) weights->insert(weights->begin() + k, weight);
+        for (size_t id = from + 1; id < offsets.size(); ++id) {
+            ++offsets[id];
+        }
+        return true;
+    }
+
+    // BFS (FIFO) або DFS (LIFO) по CSR. Шлях записується в path (якщо він є).
+    bool compact_search(uint32_t start, uint32_t end, bool depth_first,
+                        TraversalContext& context, std::vector<T>& path) const {
+        path.clear();
+        if (start == end) {
+            path.push_back(csr_nodes_[start]);
+            return true;
+        }
+
+        context.begin(csr_nodes_.size());
+        std::vector<uint32_t>& pending = context.pending();
+        size_t head = 0;
+
+        pending.push_back(start);
+        context.visit(start, start);
+
+        while (head < pending.size()) {
+            uint32_t current;
+            if (depth_first) {
+                current = pending.back();
+                pending.pop_back();
+            } else {
+                current = pending[head++];
+            }
+            context.count_explored();
+
+            if (current == end) {
+                for (uint32_t v = end; v != start; v = context.parent_of(v)) {
+                    path.push_back(csr_nodes_[v]);
+                }
+                path.push_back(csr_nodes_[start]);
+                std::reverse(path.begin(), path.end());
+                return true;
+            }
+
+            for (uint32_t k = csr_offsets_[current]; k < csr_offsets_[current + 1]; ++k) {
+                uint32_t neighbor = csr_neighbors_[k];
+                if (!context.is_visited(neighbor)) {
+                    context.visit(neighbor, current);
+                    pending.push_back(neighbor);
+                }
+            }
+        }
+        return false;
+    }
+
+    // Двонаправлений BFS: рівні розкриваються повністю, щоразу з меншого фронту.
+    // Щойно фронти зустрілися, дорівнюємо рівень до кінця й беремо найкоротший збіг.
+    bool compact_bidirectional_search(uint32_t start, uint32_t end,
+                                      TraversalContext& context, std::vector<T>& path) const {
+        path.clear();
+        if (start == end) {
+            path.push_back(csr_nodes_[start]);
+            return true;
+        }
+
+        context.begin(csr_nodes_.size());
+        std::vector<uint32_t>& forward = context.pending();
+        std::vector<uint32_t>& backward = context.pending_back();
+        size_t forward_head = 0;
+        size_t backward_head = 0;
+
+        context.visit(start, start, TraversalContext::forward_side, 0);
+        context.visit(end, end, TraversalContext::backward_side, 0);
+        forward.push_back(start);
+        backward.push_back(end);
+
+        uint32_t best_length = npos;
+        uint32_t meet_forward = npos;
+        uint32_t meet_backward = npos;
+
+        while (forward_head < forward.size() && backward_head < backward.size()) {
+            const bool expand_forward = (forward.size() - forward_head) <= (backward.size() - backward_head);
+            std::vector<uint32_t>& queue = expand_forward ? forward : backward;
+            size_t& head = expand_forward ? forward_head : backward_head;
+            const uint8_t side = expand_forward ? TraversalContext::forward_side : TraversalContext::backward_side;
+            const std::vector<uint32_t>& offsets = (expand_forward || csr_symmetric_) ? csr_offsets_ : csr_in_offsets_;
+            const std::vector<uint32_t>& targets = (expand_forward || csr_symmetric_) ? csr_neighbors_ : csr_in_neighbors_;
+
+            const size_t level_end = queue.size();
+            for (; head < level_end; ++head) {
+                uint32_t current = queue[head];
+                context.count_explored();
+                for (uint32_t k = offsets[current]; k < offsets[current + 1]; ++k) {
+                    uint32_t neighbor = targets[k];
+                    if (!context.is_visited(neighbor)) {
+                        context.visit(neighbor, current, side, context.depth_of(current) + 1);
+                        queue.push_back(neighbor);
+                    } else if (context.side_of(neighbor) != side) {
+                        uint32_t length = context.depth_of(current) + 1 + context.depth_of(neighbor);
+                        if (length < best_length) {
+                            best_length = length;
+                            meet_forward = expand_forward ? current : neighbor;
+                            meet_backward = expand_forward ? neighbor : current;
+                        }
+                    }
+                }
+            }
+
+            if (best_length != npos) {
+                for (uint32_t v = meet_forward; v != start; v = context.parent_of(v)) {
+                    path.push_back(csr_nodes_[v]);
+                }
+                path.push_back(csr_nodes_[start]);
+                std::reverse(path.begin(), path.end());
+                for (uint32_t v = meet_backward; v != end; v = context.parent_of(v)) {
+                    path.push_back(csr_nodes_[v]);
+                }
+                path.push_back(csr_nodes_[end]);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Dijkstra / A* по CSR з бінарною купою (лінива видалення застарілих записів).
+    // heuristic(const T&) має бути допустимою (не переоцінювати залишок шляху).
+    template <typename Heuristic>
+    bool compact_best_first(uint32_t start, uint32_t end, Heuristic&& heuristic,
+                            TraversalContext& context, std::vector<T>& path,
+                            weight_type* total_cost) const {
+        path.clear();
+        context.begin(csr_nodes_.size());
+        auto& heap = context.heap();
+        const auto later = [](const TraversalContext::heap_entry& a, const TraversalContext::heap_entry& b) {
+            return a.priority > b.priority;
+        };
+
+        context.visit(start, start);
+        context.set_cost(start, 0);
+        heap.push_back({ heuristic(csr_nodes_[start]), 0, start });
+
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), later);
+            const TraversalContext::heap_entry top = heap.back();
+            heap.pop_back();
+
+            if (top.cost > context.cost_of(top.node)) continue; // застарілий запис
+            context.count_explored();
+
+            if (top.node == end) {
+                for (uint32_t v = end; v != start; v = context.parent_of(v)) {
+                    path.push_back(csr_nodes_[v]);
+                }
+                path.push_back(csr_nodes_[start]);
+                std::reverse(path.begin(), path.end());
+                if (total_cost) *total_cost = top.cost;
+                return true;
+            }
+
+            for (uint32_t k = csr_offsets_[top.node]; k < csr_offsets_[top.node + 1]; ++k) {
+                uint32_t neighbor = csr_neighbors_[k];
+                weight_type cost = top.cost + csr_weights_[k];
+                if (!context.is_visited(neighbor) || cost < context.cost_of(neighbor)) {
+                    context.visit(neighbor, top.node);
+                    context.set_cost(neighbor, cost);
+                    heap.push_back({ cost + heuristic(csr_nodes_[neighbor]), cost, neighbor });
+                    std::push_heap(heap.begin(), heap.end(), later);
+                }
+            }
+        }
+        return false;
+    }
+
+    // Dijkstra / A* по хеш-представленню (до compact()), як bfs / dfs: ті самі
+    // правила, що й compact_best_first, стан пошуку — у хеш-таблицях.
+    // Порожній шлях, якщо end недосяжний.
+    template <typename Heuristic>
+    std::vector<T> hash_best_first(const T& start, const T& end, Heuristic& heuristic,
+                                   weight_type* total_cost) const {
+        if (adjacency_list.find(start) == adjacency_list.end()) {
+            throw std::runtime_error("Start node does not exist");
+        }
+        if (adjacency_list.find(end) == adjacency_list.end()) {
+            throw std::runtime_error("End node does not exist");
+        }
+
+        struct Entry {
+            weight_type priority;
+            weight_type cost;
+            T node;
+        };
+        const auto later = [](const Entry& a, const Entry& b) { return a.priority > b.priority; };
+        std::vector<Entry> heap;
+        std::unordered_map<T, weight_type> cost_of;
+        std::unordered_map<T, T> parent;
+
+        cost_of[start] = 0;
+        heap.push_back({ heuristic(start), 0, start });
+
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), later);
+            const Entry top = heap.back();
+            heap.pop_back();
+
+            if (top.cost > cost_of[top.node]) continue; // застарілий запис
+
+            if (top.node == end) {
+                if (total_cost) *total_cost = top.cost;
+                return reconstruct_path(parent, start, end);
+            }
+
+            for (const auto& edge : adjacency_list.find(top.node)->second) {
+                const T& neighbor = edge.first;
+                weight_type cost = top.cost + edge.second;
+                auto known = cost_of.find(neighbor);
+                if (known == cost_of.end() || cost < known->second) {
+                    cost_of[neighbor] = cost;
+                    parent[neighbor] = top.node;
+                    heap.push_back({ cost + heuristic(neighbor), cost, neighbor });
+                    std::push_heap(heap.begin(), heap.end(), later);
+                }
+            }
+        }
+        return {};
+    }
 
     std::vector<T> reconstruct_path(
         const std::unordered_map<T, T>& parent,
@@ -44,14 +405,20 @@ public:
     Graph() = default;
 
     bool add_node(const T& data) {
+        check_mutable();
         if (adjacency_list.find(data) != adjacency_list.end()) {
             return false;
         }
-        adjacency_list[data] = std::unordered_set<T>();
+        adjacency_list[data] = neighbor_map();
         return true;
     }
 
-    bool add_edge(const T& node1_data, const T& node2_data) {
+    // Повторне додавання існуючого ребра оновлює його вагу
+    bool add_edge(const T& node1_data, const T& node2_data, weight_type weight = 1) {
+        check_mutable();
+        if (weight < 0) {
+            throw std::runtime_error("Edge weight must be non-negative");
+        }
         if (adjacency_list.find(node1_data) == adjacency_list.end()) {
             throw std::runtime_error("Source node does not exist");
         }
@@ -59,26 +426,154 @@ public:
             throw std::runtime_error("Destination node does not exist");
         }
 
-        adjacency_list[node1_data].insert(node2_data);
+        adjacency_list[node1_data][node2_data] = weight;
         return true;
     }
 
-    bool add_undirected_edge(const T& node1_data, const T& node2_data) {
-        add_edge(node1_data, node2_data);
-        add_edge(node2_data, node1_data);
+    bool add_undirected_edge(const T& node1_data, const T& node2_data, weight_type weight = 1) {
+        add_edge(node1_data, node2_data, weight);
+        add_edge(node2_data, node1_data, weight);
         return true;
     }
 
     std::vector<T> get_neighbors(const T& data) const {
+        DUNGEON_ALLOC_SCOPE("Graph::get_neighbors");
+        if (compacted_) {
+            uint32_t id = index_of(data);
+            if (id == npos) {
+                throw std::runtime_error("Node does not exist");
+            }
+            std::vector<T> neighbors;
+            neighbors.reserve(csr_offsets_[id + 1] - csr_offsets_[id]);
+            for (uint32_t k = csr_offsets_[id]; k < csr_offsets_[id + 1]; ++k) {
+                neighbors.push_back(csr_nodes_[csr_neighbors_[k]]);
+            }
+            return neighbors;
+        }
+
         auto it = adjacency_list.find(data);
         if (it == adjacency_list.end()) {
             throw std::runtime_error("Node does not exist");
         }
-        //    
-        return std::vector<T>(it->second.begin(), it->second.end());
+        // Повертаємо копію вектора сусідів
+        std::vector<T> neighbors;
+        neighbors.reserve(it->second.size());
+        for (const auto& edge : it->second) {
+            neighbors.push_back(edge.first);
+        }
+        return neighbors;
+    }
+
+    // Обхід сусідів без копіювання: fn(const T&) викликається для кожного сусіда
+    template <typename Fn>
+    void for_each_neighbor(const T& data, Fn&& fn) const {
+        if (compacted_) {
+            uint32_t id = index_of(data);
+            if (id == npos) {
+                throw std::runtime_error("Node does not exist");
+            }
+            for (uint32_t k = csr_offsets_[id]; k < csr_offsets_[id + 1]; ++k) {
+                fn(csr_nodes_[csr_neighbors_[k]]);
+            }
+            return;
+        }
+
+        auto it = adjacency_list.find(data);
+        if (it == adjacency_list.end()) {
+            throw std::runtime_error("Node does not exist");
+        }
+        for (const auto& edge : it->second) {
+            fn(edge.first);
+        }
     }
 
-    std::vector<T> bfs(const T& start, const T& end) const {
+    // Доступ за щільним індексом (0..size()-1) для алгоритмів поверх компактного графа.
+    // node_index повертає npos_index, якщо вузла немає.
+    static constexpr uint32_t npos_index = npos;
+
+    uint32_t node_index(const T& data) const {
+        check_compact();
+        return index_of(data);
+    }
+
+    const T& node_at(uint32_t index) const { return csr_nodes_[index]; }
+
+    // fn(uint32_t neighbor_index, weight_type weight)
+    template <typename Fn>
+    void for_each_neighbor_index(uint32_t index, Fn&& fn) const {
+        for (uint32_t k = csr_offsets_[index]; k < csr_offsets_[index + 1]; ++k) {
+            fn(csr_neighbors_[k], csr_weights_[k]);
+        }
+    }
+
+    // fn(uint32_t source_index) для кожного ребра source -> index
+    template <typename Fn>
+    void for_each_incoming_index(uint32_t index, Fn&& fn) const {
+        const std::vector<uint32_t>& offsets = csr_symmetric_ ? csr_offsets_ : csr_in_offsets_;
+        const std::vector<uint32_t>& sources = csr_symmetric_ ? csr_neighbors_ : csr_in_neighbors_;
+        for (uint32_t k = offsets[index]; k < offsets[index + 1]; ++k) {
+            fn(sources[k]);
+        }
+    }
+
+    uint32_t out_degree(uint32_t index) const { return csr_offsets_[index + 1] - csr_offsets_[index]; }
+
+    size_t num_edges() const {
+        if (compacted_) return csr_neighbors_.size();
+        size_t count = 0;
+        for (const auto& pair : adjacency_list) count += pair.second.size();
+        return count;
+    }
+
+    size_t neighbor_count(const T& data) const {
+        if (compacted_) {
+            uint32_t id = index_of(data);
+            if (id == npos) {
+                throw std::runtime_error("Node does not exist");
+            }
+            return csr_offsets_[id + 1] - csr_offsets_[id];
+        }
+
+        auto it = adjacency_list.find(data);
+        if (it == adjacency_list.end()) {
+            throw std::runtime_error("Node does not exist");
+        }
+        return it->second.size();
+    }
+
+    // index-й сусід у тому ж порядку, що й у for_each_neighbor/get_neighbors.
+    // Для компактного графа O(1), інакше лінійно від index.
+    std::optional<T> neighbor_at(const T& data, size_t index) const {
+        if (compacted_) {
+            uint32_t id = index_of(data);
+            if (id == npos) {
+                throw std::runtime_error("Node does not exist");
+            }
+            if (index >= csr_offsets_[id + 1] - csr_offsets_[id]) return std::nullopt;
+            return csr_nodes_[csr_neighbors_[csr_offsets_[id] + index]];
+        }
+
+        auto it = adjacency_list.find(data);
+        if (it == adjacency_list.end()) {
+            throw std::runtime_error("Node does not exist");
+        }
+        if (index >= it->second.size()) return std::nullopt;
+        return std::next(it->second.begin(), static_cast<std::ptrdiff_t>(index))->first;
+    }
+
+    // BfsMode::Bidirectional доступний лише для компактного графа
+    std::vector<T> bfs(const T& start, const T& end, BfsMode mode = BfsMode::Forward) const {
+        DUNGEON_ALLOC_SCOPE("Graph::bfs");
+        if (compacted_) {
+            TraversalContext context;
+            std::vector<T> path;
+            bfs(start, end, context, path, mode);
+            return path;
+        }
+        if (mode != BfsMode::Forward) {
+            throw std::runtime_error("Graph is not compacted");
+        }
+
         if (adjacency_list.find(start) == adjacency_list.end()) {
             throw std::runtime_error("Start node does not exist");
         }
@@ -105,7 +600,8 @@ public:
 
             auto it = adjacency_list.find(current);
             if (it != adjacency_list.end()) {
-                for (const T& neighbor : it->second) {
+                for (const auto& edge : it->second) {
+                    const T& neighbor = edge.first;
                     if (visited.find(neighbor) == visited.end()) {
                         visited.insert(neighbor);
                         parent[neighbor] = current;
@@ -118,6 +614,18 @@ public:
     }
 
     std::vector<T> dfs(const T& start, const T& end) const {
+        DUNGEON_ALLOC_SCOPE("Graph::dfs");
+        if (compacted_) {
+            uint32_t s = index_of(start);
+            uint32_t e = index_of(end);
+            if (s == npos) throw std::runtime_error("Start node missing");
+            if (e == npos) throw std::runtime_error("End node missing");
+            TraversalContext context;
+            std::vector<T> path;
+            compact_search(s, e, true, context, path);
+            return path;
+        }
+
         if (adjacency_list.find(start) == adjacency_list.end()) throw std::runtime_error("Start node missing");
         if (adjacency_list.find(end) == adjacency_list.end()) throw std::runtime_error("End node missing");
 
@@ -138,7 +646,8 @@ public:
 
             auto it = adjacency_list.find(current);
             if (it != adjacency_list.end()) {
-                for (const T& neighbor : it->second) {
+                for (const auto& edge : it->second) {
+                    const T& neighbor = edge.first;
                     if (visited.find(neighbor) == visited.end()) {
                         visited.insert(neighbor);
                         parent[neighbor] = current;
@@ -150,19 +659,371 @@ public:
         return {};
     }
 
-    size_t size() const { return adjacency_list.size(); }
+    // Заморожує граф у CSR: вузли мають бути пронумеровані щільно (0..size()-1)
+    // через graph_node_id. Після цього add_node/add_edge кидають виняток до expand().
+    void compact() {
+        DUNGEON_ALLOC_SCOPE("Graph::compact");
+        if (compacted_) return;
+
+        const size_t n = adjacency_list.size();
+        size_t num_edges = 0;
+        for (const auto& pair : adjacency_list) {
+            num_edges += pair.second.size();
+        }
+        if (n >= npos || num_edges >= npos) {
+            throw std::runtime_error("Graph is too large to compact");
+        }
+
+        graph_node_id<T> id_of;
+        std::vector<T> nodes(n);
+        std::vector<bool> seen(n, false);
+        std::vector<uint32_t> offsets(n + 1, 0);
+        for (const auto& pair : adjacency_list) {
+            size_t id = id_of(pair.first);
+            if (id >= n || seen[id]) {
+                throw std::runtime_error("Node ids are not dense");
+            }
+            seen[id] = true;
+            nodes[id] = pair.first;
+            offsets[id + 1] = static_cast<uint32_t>(pair.second.size());
+        }
+        for (size_t i = 0; i < n; ++i) {
+            offsets[i + 1] += offsets[i];
+        }
+
+        std::vector<uint32_t> neighbors(num_edges);
+        std::vector<weight_type> weights(num_edges);
+        std::vector<std::pair<uint32_t, weight_type>> edges;
+        for (const auto& pair : adjacency_list) {
+            size_t id = id_of(pair.first);
+            edges.clear();
+            for (const auto& edge : pair.second) {
+                edges.emplace_back(static_cast<uint32_t>(id_of(edge.first)), edge.second);
+            }
+            std::sort(edges.begin(), edges.end());
+
+            uint32_t pos = offsets[id];
+            for (const auto& edge : edges) {
+                neighbors[pos] = edge.first;
+                weights[pos] = edge.second;
+                ++pos;
+            }
+        }
+
+        install_csr(std::move(nodes), std::move(offsets), std::move(neighbors), std::move(weights));
+        std::unordered_map<T, neighbor_map>().swap(adjacency_list);
+    }
+
+    // Будує компактний неорієнтований граф одразу з переліку ребер за щільними
+    // індексами, без проміжних хеш-таблиць. nodes[i] має мати id i. Петлі й
+    // повторні ребра відкидаються, ваги — 1. Сортування списків сусідів ділиться
+    // між num_threads потоками; результат від кількості потоків не залежить.
+    void assign_undirected(std::vector<T> nodes, const std::vector<std::pair<uint32_t, uint32_t>>& edges,
+                           unsigned num_threads = 1) {
+        const size_t n = nodes.size();
+        if (n >= npos || edges.size() * 2 >= npos) {
+            throw std::runtime_error("Graph is too large to compact");
+        }
+        graph_node_id<T> id_of;
+        for (size_t i = 0; i < n; ++i) {
+            if (id_of(nodes[i]) != i) throw std::runtime_error("Node ids are not dense");
+        }
+
+        // Обидва напрямки кожного ребра
+        std::vector<uint32_t> offsets(n + 1, 0);
+        for (const auto& edge : edges) {
+            if (edge.first >= n || edge.second >= n) throw std::runtime_error("Node does not exist");
+            if (edge.first == edge.second) continue;
+            ++offsets[edge.first + 1];
+            ++offsets[edge.second + 1];
+        }
+        for (size_t i = 0; i < n; ++i) {
+            offsets[i + 1] += offsets[i];
+        }
+        std::vector<uint32_t> neighbors(offsets[n]);
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (const auto& edge : edges) {
+            if (edge.first == edge.second) continue;
+            neighbors[fill[edge.first]++] = edge.second;
+            neighbors[fill[edge.second]++] = edge.first;
+        }
+
+        // Сортування й видалення дублікатів у межах кожного вузла (паралельно),
+        // потім стискання масиву
+        std::vector<uint32_t> degree(n);
+        parallel_for(n, num_threads, [&](size_t begin, size_t end, unsigned) {
+            for (size_t id = begin; id < end; ++id) {
+                auto first = neighbors.begin() + offsets[id];
+                auto last = neighbors.begin() + offsets[id + 1];
+                std::sort(first, last);
+                degree[id] = static_cast<uint32_t>(std::unique(first, last) - first);
+            }
+        });
+
+        uint32_t pos = 0;
+        for (size_t id = 0; id < n; ++id) {
+            const uint32_t start = offsets[id];
+            offsets[id] = pos;
+            std::copy(neighbors.begin() + start, neighbors.begin() + start + degree[id], neighbors.begin() + pos);
+            pos += degree[id];
+        }
+        offsets[n] = pos;
+        neighbors.resize(pos);
+        neighbors.shrink_to_fit();
+
+        clear();
+        csr_nodes_ = std::move(nodes);
+        csr_offsets_ = std::move(offsets);
+        csr_weights_.assign(neighbors.size(), weight_type(1));
+        csr_neighbors_ = std::move(neighbors);
+        csr_symmetric_ = true;
+        compacted_ = true;
+    }
+
+    // Встановлює готовий CSR (наприклад, зі збереженого знімка): offsets — n + 1
+    // зростаючих зсувів, сусіди кожного вузла відсортовані за id, ваги — 1.
+    // Некоректні масиви відкидаються з винятком. Симетричність перевіряється заново.
+    void assign_csr(std::vector<T> nodes, std::vector<uint32_t> offsets, std::vector<uint32_t> neighbors) {
+        const size_t n = nodes.size();
+        if (n >= npos || neighbors.size() >= npos) {
+            throw std::runtime_error("Graph is too large to compact");
+        }
+        if (offsets.size() != n + 1 || offsets[0] != 0 || offsets[n] != neighbors.size()) {
+            throw std::runtime_error("Invalid CSR offsets");
+        }
+        graph_node_id<T> id_of;
+        for (size_t id = 0; id < n; ++id) {
+            if (id_of(nodes[id]) != id) throw std::runtime_error("Node ids are not dense");
+            if (offsets[id] > offsets[id + 1]) throw std::runtime_error("Invalid CSR offsets");
+            for (uint32_t k = offsets[id]; k < offsets[id + 1]; ++k) {
+                if (neighbors[k] >= n || (k > offsets[id] && neighbors[k - 1] >= neighbors[k])) {
+                    throw std::runtime_error("Invalid CSR neighbors");
+                }
+            }
+        }
+
+        clear();
+        std::vector<weight_type> weights(neighbors.size(), weight_type(1));
+        install_csr(std::move(nodes), std::move(offsets), std::move(neighbors), std::move(weights));
+    }
+
+    // Сирі CSR-масиви компактного графа (для збереження)
+    const std::vector<uint32_t>& csr_offsets() const { check_compact(); return csr_offsets_; }
+    const std::vector<uint32_t>& csr_neighbors() const { check_compact(); return csr_neighbors_; }
+
+    // Кожне ребро компактного графа має зворотне (вхідні ребра збігаються з вихідними)
+    bool is_symmetric() const { check_compact(); return csr_symmetric_; }
+
+    // Ребро у вже компактному графі без повернення в хеш-представлення: вставка
+    // в CSR на місці, O(V + E) копіювання масивів замість перебудови через хеш-таблиці.
+    // Повторне додавання існуючого ребра оновлює його вагу.
+    bool insert_edge(const T& node1_data, const T& node2_data, weight_type weight = 1) {
+        check_compact();
+        if (weight < 0) {
+            throw std::runtime_error("Edge weight must be non-negative");
+        }
+        const uint32_t from = index_of(node1_data);
+        const uint32_t to = index_of(node2_data);
+        if (from == npos) throw std::runtime_error("Source node does not exist");
+        if (to == npos) throw std::runtime_error("Destination node does not exist");
+        if (csr_neighbors_.size() + 1 >= npos) throw std::runtime_error("Graph is too large to compact");
+
+        if (csr_symmetric_ && !has_edge(node1_data, node2_data)) {
+            // Ребро без пари робить граф несиметричним: вхідні ребра тепер окремо
+            csr_in_offsets_ = csr_offsets_;
+            csr_in_neighbors_ = csr_neighbors_;
+            csr_symmetric_ = false;
+        }
+        csr_insert(csr_offsets_, csr_neighbors_, &csr_weights_, from, to, weight);
+        if (!csr_symmetric_) {
+            csr_insert(csr_in_offsets_, csr_in_neighbors_, nullptr, to, from, weight);
+        }
+        return true;
+    }
+
+    bool insert_undirected_edge(const T& node1_data, const T& node2_data, weight_type weight = 1) {
+        check_compact();
+        if (!csr_symmetric_) {
+            insert_edge(node1_data, node2_data, weight);
+            insert_edge(node2_data, node1_data, weight);
+            return true;
+        }
+        // Обидва напрямки одразу: симетричний граф таким і лишається
+        if (weight < 0) {
+            throw std::runtime_error("Edge weight must be non-negative");
+        }
+        const uint32_t from = index_of(node1_data);
+        const uint32_t to = index_of(node2_data);
+        if (from == npos) throw std::runtime_error("Source node does not exist");
+        if (to == npos) throw std::runtime_error("Destination node does not exist");
+        if (csr_neighbors_.size() + 2 >= npos) throw std::runtime_error("Graph is too large to compact");
+
+        csr_insert(csr_offsets_, csr_neighbors_, &csr_weights_, from, to, weight);
+        if (from != to) {
+            csr_insert(csr_offsets_, csr_neighbors_, &csr_weights_, to, from, weight);
+        }
+        return true;
+    }
+
+    // Повертає граф у хеш-представлення, щоб знову можна було додавати вузли й ребра
+    void expand() {
+        if (!compacted_) return;
+
+        std::unordered_map<T, neighbor_map> adjacency;
+        adjacency.reserve(csr_nodes_.size());
+        for (size_t id = 0; id < csr_nodes_.size(); ++id) {
+            auto& edges = adjacency[csr_nodes_[id]];
+            for (uint32_t k = csr_offsets_[id]; k < csr_offsets_[id + 1]; ++k) {
+                edges[csr_nodes_[csr_neighbors_[k]]] = csr_weights_[k];
+            }
+        }
+
+        adjacency_list = std::move(adjacency);
+        std::vector<T>().swap(csr_nodes_);
+        std::vector<uint32_t>().swap(csr_offsets_);
+        std::vector<uint32_t>().swap(csr_neighbors_);
+        std::vector<weight_type>().swap(csr_weights_);
+        std::vector<uint32_t>().swap(csr_in_offsets_);
+        std::vector<uint32_t>().swap(csr_in_neighbors_);
+        csr_symmetric_ = true;
+        compacted_ = false;
+    }
+
+    bool is_compact() const { return compacted_; }
+
+    // Пам'ять під структуру графа в байтах (для хеш-таблиць — наближено)
+    size_t memory_bytes() const {
+        size_t bytes = csr_nodes_.capacity() * sizeof(T) +
+            (csr_offsets_.capacity() + csr_neighbors_.capacity() +
+             csr_in_offsets_.capacity() + csr_in_neighbors_.capacity()) * sizeof(uint32_t) +
+            csr_weights_.capacity() * sizeof(weight_type);
+
+        bytes += adjacency_list.bucket_count() * sizeof(void*);
+        for (const auto& pair : adjacency_list) {
+            bytes += sizeof(void*) + sizeof(pair) + pair.second.bucket_count() * sizeof(void*) +
+                pair.second.size() * (sizeof(void*) + sizeof(typename neighbor_map::value_type));
+        }
+        return bytes;
+    }
+
+    void clear() {
+        adjacency_list.clear();
+        csr_nodes_.clear();
+        csr_offsets_.clear();
+        csr_neighbors_.clear();
+        csr_weights_.clear();
+        csr_in_offsets_.clear();
+        csr_in_neighbors_.clear();
+        csr_symmetric_ = true;
+        compacted_ = false;
+    }
+
+    // Варіанти bfs/dfs для повторних запитів по компактному графу: context і path
+    // перевикористовуються між викликами, тож на "теплих" буферах пам'ять не виділяється.
+    // Повертають false, якщо шляху немає (path тоді порожній).
+    // Кількість розкритих вузлів останнього запиту — context.explored().
+    bool bfs(const T& start, const T& end, TraversalContext& context, std::vector<T>& path,
+             BfsMode mode = BfsMode::Forward) const {
+        check_compact();
+        uint32_t s = index_of(start);
+        uint32_t e = index_of(end);
+        if (s == npos) throw std::runtime_error("Start node does not exist");
+        if (e == npos) throw std::runtime_error("End node does not exist");
+        if (mode == BfsMode::Bidirectional) {
+            return compact_bidirectional_search(s, e, context, path);
+        }
+        return compact_search(s, e, false, context, path);
+    }
+
+    bool dfs(const T& start, const T& end, TraversalContext& context, std::vector<T>& path) const {
+        check_compact();
+        uint32_t s = index_of(start);
+        uint32_t e = index_of(end);
+        if (s == npos) throw std::runtime_error("Start node missing");
+        if (e == npos) throw std::runtime_error("End node missing");
+        return compact_search(s, e, true, context, path);
+    }
+
+    // Найдешевший шлях за вагами ребер (Dijkstra). Працює і до compact() — по
+    // хеш-представленню, як bfs / dfs; тоді context не використовується.
+    std::vector<T> dijkstra(const T& start, const T& end) const {
+        TraversalContext context;
+        std::vector<T> path;
+        dijkstra(start, end, context, path);
+        return path;
+    }
+
+    bool dijkstra(const T& start, const T& end, TraversalContext& context, std::vector<T>& path,
+                  weight_type* total_cost = nullptr) const {
+        return a_star(start, end, [](const T&) { return weight_type(0); }, context, path, total_cost);
+    }
+
+    // A*: heuristic(const T& node) — оцінка знизу вартості від node до end
+    template <typename Heuristic>
+    std::vector<T> a_star(const T& start, const T& end, Heuristic&& heuristic) const {
+        TraversalContext context;
+        std::vector<T> path;
+        a_star(start, end, std::forward<Heuristic>(heuristic), context, path);
+        return path;
+    }
+
+    template <typename Heuristic>
+    bool a_star(const T& start, const T& end, Heuristic&& heuristic, TraversalContext& context,
+                std::vector<T>& path, weight_type* total_cost = nullptr) const {
+        if (!compacted_) {
+            path = hash_best_first(start, end, heuristic, total_cost);
+            return !path.empty();
+        }
+        uint32_t s = index_of(start);
+        uint32_t e = index_of(end);
+        if (s == npos) throw std::runtime_error("Start node does not exist");
+        if (e == npos) throw std::runtime_error("End node does not exist");
+        return compact_best_first(s, e, heuristic, context, path, total_cost);
+    }
+
+    size_t size() const { return compacted_ ? csr_nodes_.size() : adjacency_list.size(); }
 
     bool has_node(const T& data) const {
+        if (compacted_) return index_of(data) != npos;
         return adjacency_list.find(data) != adjacency_list.end();
     }
 
     bool has_edge(const T& node1_data, const T& node2_data) const {
+        if (compacted_) {
+            uint32_t from = index_of(node1_data);
+            uint32_t to = index_of(node2_data);
+            if (from == npos || to == npos) return false;
+            return std::binary_search(csr_neighbors_.begin() + csr_offsets_[from],
+                                      csr_neighbors_.begin() + csr_offsets_[from + 1], to);
+        }
+
         auto it = adjacency_list.find(node1_data);
         if (it == adjacency_list.end()) return false;
         return it->second.find(node2_data) != it->second.end();
     }
 
+    std::optional<weight_type> edge_weight(const T& node1_data, const T& node2_data) const {
+        if (compacted_) {
+            uint32_t from = index_of(node1_data);
+            uint32_t to = index_of(node2_data);
+            if (from == npos || to == npos) return std::nullopt;
+            auto first = csr_neighbors_.begin() + csr_offsets_[from];
+            auto last = csr_neighbors_.begin() + csr_offsets_[from + 1];
+            auto pos = std::lower_bound(first, last, to);
+            if (pos == last || *pos != to) return std::nullopt;
+            return csr_weights_[pos - csr_neighbors_.begin()];
+        }
+
+        auto it = adjacency_list.find(node1_data);
+        if (it == adjacency_list.end()) return std::nullopt;
+        auto edge = it->second.find(node2_data);
+        if (edge == it->second.end()) return std::nullopt;
+        return edge->second;
+    }
+
     std::vector<T> get_all_nodes() const {
+        if (compacted_) return csr_nodes_;
+
         std::vector<T> nodes;
         nodes.reserve(adjacency_list.size());
         for (const auto& pair : adjacency_list) {
@@ -1,17 +1,28 @@
 #ifndef ITEM_HPP
 #define ITEM_HPP
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 class Character; // Forward declaration
 
+// Вид предмета (для серіалізації та фабрики GameMap)
+enum class ItemKind : uint8_t {
+    Weapon,
+    Armor,
+    Potion
+};
+
+// Назва й опис — string_view на статичні рядки (names::*, літерали),
+// тож предмет не копіює текст; рядки мають жити довше за предмет.
 class Item {
 protected:
-    std::string name_;
-    std::string description_;
+    std::string_view name_;
+    std::string_view description_;
 
 public:
-    Item(const std::string& name, const std::string& description)
+    Item(std::string_view name, std::string_view description)
         : name_(name), description_(description) {
     }
 
@@ -20,12 +31,17 @@ public:
     // ЗМІНА: Повертає опис результату використання
     virtual std::string use(Character* character) = 0;
 
-    std::string get_name() const { return name_; }
-    std::string get_description() const { return description_; }
+    virtual ItemKind get_item_kind() const = 0;
+
+    // Основна величина предмета: шкода зброї, захист броні, лікування зілля
+    virtual int get_value() const = 0;
+
+    std::string_view get_name() const { return name_; }
+    std::string_view get_description() const { return description_; }
 
     // ЗМІНА: Повертає рядок замість друку в консоль
     virtual std::string get_info_string() const {
-        return name_ + ": " + description_;
+        return std::string(name_) + ": " + std::string(description_);
     }
 };
 
@@ -0,0 +1,103 @@
+#ifndef LOGMODEL_HPP
+#define LOGMODEL_HPP
+
+#include <QAbstractListModel>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+// Журнал гри як модель для QListView: кільцевий буфер на capacity рядків.
+// Повідомлення накопичуються й додаються пачкою раз на кадр (flushIntervalMs),
+// а найстаріші рядки витісняються, тож пам'ять і ціна додавання не ростуть
+// разом із довжиною сесії. Вид з uniformItemSizes розкладає лише видимі рядки.
+// Багаторядкові повідомлення діляться на окремі рядки моделі.
+class LogModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    static constexpr int defaultCapacity = 2000;
+    static constexpr int flushIntervalMs = 16;
+
+    explicit LogModel(int capacity = defaultCapacity, QObject* parent = nullptr)
+        : QAbstractListModel(parent), lines_(capacity > 0 ? capacity : 1) {
+        flushTimer_.setSingleShot(true);
+        flushTimer_.setInterval(flushIntervalMs);
+        connect(&flushTimer_, &QTimer::timeout, this, &LogModel::flush);
+    }
+
+    int capacity() const { return lines_.size(); }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override {
+        return parent.isValid() ? 0 : size_;
+    }
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override {
+        if (role != Qt::DisplayRole || !index.isValid() || index.row() >= size_) return QVariant();
+        return lines_[(head_ + index.row()) % lines_.size()];
+    }
+
+signals:
+    // Пачку додано (наприклад, щоб прокрутити вид донизу)
+    void batchAppended();
+
+public slots:
+    // Додає повідомлення до наступної пачки
+    void append(const QString& message) {
+        pending_ += message.split('\n');
+        if (!flushTimer_.isActive()) flushTimer_.start();
+    }
+
+    // Додає накопичену пачку одразу
+    void flush() {
+        flushTimer_.stop();
+        if (pending_.isEmpty()) return;
+
+        const int cap = lines_.size();
+        const int incoming = pending_.size();
+        if (incoming >= cap) {
+            // Пачка більша за буфер: лишаються її останні cap рядків
+            beginResetModel();
+            for (int i = 0; i < cap; ++i) lines_[i] = pending_[incoming - cap + i];
+            head_ = 0;
+            size_ = cap;
+            endResetModel();
+        } else {
+            const int overflow = size_ + incoming - cap;
+            if (overflow > 0) {
+                beginRemoveRows(QModelIndex(), 0, overflow - 1);
+                head_ = (head_ + overflow) % cap;
+                size_ -= overflow;
+                endRemoveRows();
+            }
+            beginInsertRows(QModelIndex(), size_, size_ + incoming - 1);
+            for (const QString& line : pending_) {
+                lines_[(head_ + size_) % cap] = line;
+                ++size_;
+            }
+            endInsertRows();
+        }
+        pending_.clear();
+        emit batchAppended();
+    }
+
+    // Порожній журнал (нова гра); неопубліковану пачку теж відкидаємо
+    void clear() {
+        flushTimer_.stop();
+        pending_.clear();
+        beginResetModel();
+        for (QString& line : lines_) line.clear();
+        head_ = 0;
+        size_ = 0;
+        endResetModel();
+    }
+
+private:
+    QVector<QString> lines_; // Кільце: рядок row лежить у lines_[(head_ + row) % capacity]
+    int head_ = 0;
+    int size_ = 0;
+    QStringList pending_;
+    QTimer flushTimer_;
+};
+
+#endif // LOGMODEL_HPP
@@ -10,16 +10,19 @@ public:
         : Player(name, 80, 30, 5) {
     }
 
-    std::string attack(Character& target) override {
+    int attack(Character& target) override {
         // Магія ігнорує захист
         int damage = attack_power_;
         int old_hp = target.get_hp();
         target.set_hp(old_hp - damage);
 
-        return "🔥 " + name_ + " кастує закляття! " + target.get_name() +
-            " отримує " + std::to_string(damage) + " шкоди (ІГНОР ЗАХИСТУ).";
+        int dealt = old_hp - target.get_hp();
+        record_event(CombatEventKind::Spell, target, damage); // Текст показує силу закляття
+        return dealt;
     }
 
+    CombatKind get_combat_kind() const override { return CombatKind::Mage; }
+
     std::string get_stats_string() const override {
         return Player::get_stats_string() + " [Клас: Маг (Ігнор захисту)]";
     }
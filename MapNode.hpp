@@ -1,53 +1,56 @@
 #ifndef MAPNODE_HPP
 #define MAPNODE_HPP
 
-#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
 
-class Enemy;
-class Item;
+#include "NameTables.hpp"
 
+// Кімната карти — 16 байт, без вказівників: 32-бітний id (він же ключ у Graph),
+// індекси ворога й предмета в сховищах GameMap і індекси опису в names::*.
+// Самі об'єкти Enemy / Item видає GameMap (get_enemy / get_item); ставить і
+// прибирає їх теж лише GameMap, бо веде лічильники живих ворогів.
 class MapNode {
-private:
-    int id_;
-    std::string description_;
-    Enemy* enemy_;  // Non-owning pointer
-    Item* item_;    // Non-owning pointer
+    friend class GameMap;
+    friend struct SnapshotAccess; // Відновлення кімнат зі знімка
 
 public:
-    MapNode(int id, const std::string& description, Enemy* enemy = nullptr, Item* item = nullptr)
-        : id_(id), description_(description), enemy_(enemy), item_(item) {
-    }
+    static constexpr uint32_t no_index = std::numeric_limits<uint32_t>::max();
+
+private:
+    uint32_t id_;
+    uint32_t enemy_ = no_index;  // Індекс у GameMap::enemies_
+    uint32_t item_ = no_index;   // Індекс у GameMap::items_
+    uint8_t type_;     // Індекс у names::room_types
+    uint8_t feature_;  // Індекс у names::room_features
 
-    ~MapNode() = default;
+    void set_enemy_index(uint32_t index) { enemy_ = index; }
+    void set_item_index(uint32_t index) { item_ = index; }
 
-    int get_id() const { return id_; }
-    std::string get_description() const { return description_; }
-    Enemy* get_enemy() const { return enemy_; }
-    Item* get_item() const { return item_; }
+    void clear_enemy() { enemy_ = no_index; }
+    void clear_item() { item_ = no_index; }
+
+public:
+    MapNode(uint32_t id, uint8_t type, uint8_t feature)
+        : id_(id), type_(type), feature_(feature) {
+    }
 
-    void set_description(const std::string& desc) { description_ = desc; }
-    void set_enemy(Enemy* enemy) { enemy_ = enemy; }
-    void set_item(Item* item) { item_ = item; }
+    uint32_t get_id() const { return id_; }
+    std::string_view get_description() const { return names::room_description(type_, feature_); }
+    uint8_t get_type() const { return type_; }
+    uint8_t get_feature() const { return feature_; }
 
-    bool has_enemy() const { return enemy_ != nullptr; }
-    bool has_item() const { return item_ != nullptr; }
+    uint32_t get_enemy_index() const { return enemy_; }
+    uint32_t get_item_index() const { return item_; }
 
-    void clear_enemy() { enemy_ = nullptr; }
-    void clear_item() { item_ = nullptr; }
+    bool has_enemy() const { return enemy_ != no_index; }
+    bool has_item() const { return item_ != no_index; }
 
     bool operator==(const MapNode& other) const {
         return id_ == other.id_;
     }
 };
 
-// Хеш для роботи з Graph (якщо він використовує unordered_map)
-namespace std {
-    template <>
-    struct hash<MapNode*> {
-        size_t operator()(MapNode* const& node) const {
-            return hash<int>()(node->get_id());
-        }
-    };
-}
-
-#endif // MAPNODE_HPP
\ No newline at end of file
+#endif // MAPNODE_HPP
@@ -0,0 +1,68 @@
+#ifndef NAMETABLES_HPP
+#define NAMETABLES_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// Інтерновані таблиці назв. Усі рядки статичні, тож кімнати й предмети
+// зберігають лише індекси або string_view і нічого не виділяють під текст.
+
+namespace names {
+
+constexpr std::array<std::string_view, 10> room_types = {
+    "Темний коридор", "Стародавня зала", "Затхле підземелля",
+    "Кам'яний прохід", "Освітлений факелами прохід", "Занедбаний склеп",
+    "Таємнича скарбниця", "Тінява ніша", "Зруйнована крипта", "Підземна печера"
+};
+
+constexpr std::array<std::string_view, 10> room_features = {
+    "вкрита павутинням", "з якої крапає вода", "зі смородом гнилі",
+    "що відлунює шепотами", "вкрита мохом", "сповнена туману",
+    "обкладена кістками", "вирізьблена рунами", "тьмяно освітлена", "моторошно тиха"
+};
+
+constexpr std::array<std::string_view, 5> weapon_names = {
+    "Іржавий меч", "Залізна сокира", "Стальний кинджал", "Стародавня булава", "Ельфійський лук"
+};
+
+constexpr std::array<std::string_view, 5> armor_names = {
+    "Шкіряний жилет", "Кольчуга", "Залізний щит", "Латний обладунок", "Магічний плащ"
+};
+
+constexpr std::array<std::string_view, 5> potion_names = {
+    "Зілля здоров'я", "Еліксир", "Цілющий настій", "Фляга відновлення", "Есенція життя"
+};
+
+constexpr std::string_view weapon_description = "Надійна зброя";
+constexpr std::string_view armor_description = "Захисне спорядження";
+constexpr std::string_view potion_description = "Відновлює здоров'я";
+
+// Повний опис кімнати "тип особливість". Усі комбінації складаються один раз
+// (потокобезпечна ініціалізація статичної змінної), далі — лише string_view.
+// Тип і особливість перевіряються окремо: інакше завелика особливість дала б
+// опис іншої кімнати замість винятку.
+inline std::string_view room_description(uint8_t type, uint8_t feature) {
+    static const auto table = [] {
+        std::array<std::string, room_types.size() * room_features.size()> result;
+        for (size_t t = 0; t < room_types.size(); ++t) {
+            for (size_t f = 0; f < room_features.size(); ++f) {
+                std::string& text = result[t * room_features.size() + f];
+                text.reserve(room_types[t].size() + 1 + room_features[f].size());
+                text.append(room_types[t]).append(" ").append(room_features[f]);
+            }
+        }
+        return result;
+    }();
+    if (type >= room_types.size() || feature >= room_features.size()) {
+        throw std::out_of_range("Invalid room description index");
+    }
+    return table[static_cast<size_t>(type) * room_features.size() + feature];
+}
+
+} // namespace names
+
+#endif // NAMETABLES_HPP
@@ -10,13 +10,15 @@ public:
         : Enemy(name, 100, 20, 10) {
     }
 
-    std::string attack(Character& target) override {
+    int attack(Character& target) override {
         int damage = static_cast<int>(attack_power_ * 1.1); // 110% damage
-        std::string damage_log = target.take_damage(damage);
-
-        return "👹 " + name_ + " (Орк) завдає БРУТАЛЬНОГО УДАРУ! " + damage_log;
+        int dealt = target.take_damage(damage);
+        record_event(CombatEventKind::BrutalStrike, target, dealt);
+        return dealt;
     }
 
+    CombatKind get_combat_kind() const override { return CombatKind::Orc; }
+
     std::string get_stats_string() const override {
         return Character::get_stats_string() + " (Орк: +10% пошкоджень)";
     }
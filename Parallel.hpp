@@ -0,0 +1,180 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Trace.hpp"
+
+// Кількість потоків за замовчуванням (0 -> усі ядра)
+inline unsigned resolve_thread_count(unsigned requested) {
+    if (requested > 0) return requested;
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? hardware : 1;
+}
+
+// Постійні робочі потоки для parallel_for: створюються при першій потребі
+// (стільки, скільки найбільше просили) і чекають на наступне завдання, тож
+// виклик parallel_for не запускає нових потоків. Одночасно виконується одне
+// завдання; вкладений або паралельний виклик з іншого потоку виконує свої
+// частини сам, по черзі — результат від цього не змінюється.
+class WorkerPool {
+public:
+    // task(context, part) для part у [0, num_parts)
+    using Task = void (*)(void* context, unsigned part);
+
+private:
+    std::mutex run_mutex_; // Тримає той, чиє завдання зараз виконується
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::vector<std::thread> workers_;
+
+    Task task_ = nullptr;
+    void* context_ = nullptr;
+    unsigned num_parts_ = 0;
+    unsigned remaining_ = 0;
+    uint64_t generation_ = 0;
+    bool stopping_ = false;
+    std::exception_ptr error_;
+
+    static bool& is_worker_thread() {
+        thread_local bool worker = false;
+        return worker;
+    }
+
+    // Робочий потік index виконує частину index + 1 кожного завдання (частина 0 — того, хто викликав)
+    void worker_loop(unsigned index, uint64_t seen_generation) {
+        is_worker_thread() = true;
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            wake_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+            if (stopping_) return;
+            seen_generation = generation_;
+
+            const unsigned part = index + 1;
+            if (part >= num_parts_) continue;
+            const Task task = task_;
+            void* context = context_;
+            lock.unlock();
+
+            std::exception_ptr error;
+            try {
+                task(context, part);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            if (error && !error_) error_ = error;
+            if (--remaining_ == 0) done_.notify_one();
+        }
+    }
+
+    static void run_inline(unsigned num_parts, Task task, void* context) {
+        for (unsigned part = 0; part < num_parts; ++part) {
+            task(context, part);
+        }
+    }
+
+public:
+    WorkerPool() = default;
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Спільний пул процесу
+    static WorkerPool& shared() {
+        static WorkerPool pool;
+        return pool;
+    }
+
+    // Виконує task для частин 0..num_parts-1 і чекає на всі; виняток першої
+    // частини, що впала, передається далі
+    void run(unsigned num_parts, Task task, void* context) {
+        if (num_parts <= 1 || is_worker_thread()) {
+            run_inline(num_parts, task, context);
+            return;
+        }
+        std::unique_lock<std::mutex> run_lock(run_mutex_, std::try_to_lock);
+        if (!run_lock.owns_lock()) {
+            run_inline(num_parts, task, context);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            while (workers_.size() + 1 < num_parts) {
+                const unsigned index = static_cast<unsigned>(workers_.size());
+                workers_.emplace_back(&WorkerPool::worker_loop, this, index, generation_);
+            }
+            task_ = task;
+            context_ = context;
+            num_parts_ = num_parts;
+            remaining_ = num_parts - 1;
+            error_ = nullptr;
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        std::exception_ptr error;
+        try {
+            task(context, 0);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [&] { return remaining_ == 0; });
+        if (!error) error = error_;
+        error_ = nullptr;
+        lock.unlock();
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+// Ділить [0, count) на num_threads суцільних шматків і викликає
+// fn(begin, end, thread_index) для кожного на окремому потоці WorkerPool.
+// Шматок thread_index завжди йде перед thread_index + 1, тож результати,
+// зібрані по потоках у порядку індексу, не залежать від планування.
+template <typename Fn>
+void parallel_for(size_t count, unsigned num_threads, Fn&& fn) {
+    num_threads = std::max(1u, num_threads);
+    if (num_threads == 1 || count < 2) {
+        fn(size_t(0), count, 0u);
+        return;
+    }
+
+    struct Chunks {
+        size_t count;
+        size_t chunk;
+        Fn& fn;
+    };
+    Chunks chunks{ count, (count + num_threads - 1) / num_threads, fn };
+
+    WorkerPool::shared().run(num_threads, [](void* context, unsigned t) {
+        DUNGEON_TRACE_SCOPE("parallel_for");
+        Chunks& c = *static_cast<Chunks*>(context);
+        const size_t begin = std::min(c.count, t * c.chunk);
+        c.fn(begin, std::min(c.count, begin + c.chunk), t);
+    }, &chunks);
+}
+
+#endif // PARALLEL_HPP
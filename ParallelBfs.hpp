@@ -0,0 +1,274 @@
+#ifndef PARALLELBFS_HPP
+#define PARALLELBFS_HPP
+
+#include "Graph.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Статистика останнього parallel_bfs (скільки рівнів пройдено в кожному напрямку)
+struct ParallelBfsStats {
+    unsigned top_down_levels = 0;
+    unsigned bottom_up_levels = 0;
+};
+
+class ParallelBfsContext;
+
+template <typename T>
+std::vector<T> parallel_bfs(const Graph<T>& graph, ParallelBfsContext& context, const T& start, const T& end,
+                            unsigned num_threads = 0, ParallelBfsStats* stats = nullptr);
+
+// Робочий простір parallel_bfs для повторних запитів (як TraversalContext для bfs):
+// масиви на n вузлів виділяються один раз, а після запиту скидаються лише ті
+// вузли, яких він торкнувся. Один контекст — один запит одночасно.
+class ParallelBfsContext {
+    template <typename T>
+    friend std::vector<T> parallel_bfs(const Graph<T>&, ParallelBfsContext&, const T&, const T&,
+                                       unsigned, ParallelBfsStats*);
+
+public:
+    static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+private:
+    // Для кожного вузла: рівень, батько, позиція у своєму фронті,
+    // найменша позиція батька-претендента (top-down)
+    std::vector<uint32_t> level_of_;
+    std::vector<uint32_t> parent_;
+    std::vector<uint32_t> frontier_pos_;
+    std::unique_ptr<std::atomic<uint32_t>[]> claim_;
+    size_t capacity_ = 0;
+
+    // Усі вузли, яким запит присвоїв рівень (для скидання)
+    std::vector<uint32_t> touched_;
+    std::vector<uint32_t> frontier_;
+    std::vector<uint32_t> next_;
+    std::vector<uint32_t> slot_;
+    std::vector<std::vector<uint32_t>> local_next_;
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> local_found_;
+
+    void prepare(size_t num_nodes, unsigned threads) {
+        if (capacity_ < num_nodes) {
+            level_of_.resize(num_nodes, none);
+            parent_.resize(num_nodes, none);
+            frontier_pos_.resize(num_nodes, none);
+            std::unique_ptr<std::atomic<uint32_t>[]> claim(new std::atomic<uint32_t>[num_nodes]);
+            for (size_t i = 0; i < num_nodes; ++i) claim[i].store(none, std::memory_order_relaxed);
+            claim_ = std::move(claim);
+            capacity_ = num_nodes;
+            touched_.reserve(num_nodes);
+        }
+        if (local_next_.size() < threads) {
+            local_next_.resize(threads);
+            local_found_.resize(threads);
+        }
+        frontier_.clear();
+        next_.clear();
+    }
+
+    void visit(uint32_t node, uint32_t parent, uint32_t level, uint32_t pos) {
+        level_of_[node] = level;
+        parent_[node] = parent;
+        frontier_pos_[node] = pos;
+        touched_.push_back(node);
+    }
+
+    // Повертає торкнуті вузли до стану "не відвідано". parent_ і frontier_pos_
+    // читаються лише для вузлів з рівнем, тож їх скидати не треба
+    void reset(unsigned threads) {
+        parallel_for(touched_.size(), threads, [&](size_t begin, size_t end, unsigned) {
+            for (size_t i = begin; i < end; ++i) {
+                const uint32_t v = touched_[i];
+                level_of_[v] = none;
+                claim_[v].store(none, std::memory_order_relaxed);
+            }
+        });
+        touched_.clear();
+    }
+
+public:
+    ParallelBfsContext() = default;
+};
+
+// Рівнево-синхронний BFS по компактному графу на кількох потоках, з перемиканням
+// top-down / bottom-up (direction-optimizing BFS, Beamer et al.).
+//
+// Результат збігається з Graph::bfs (BfsMode::Forward) вузол у вузол: порядок
+// кожного фронту відтворює порядок черги послідовного bfs (за позицією батька у
+// фронті, далі за id сусіда, бо списки сусідів у CSR відсортовані), а батьком
+// вузла завжди стає найперший у цьому порядку вузол попереднього рівня.
+// Рівні виконуються на постійних потоках WorkerPool (див. parallel_for).
+template <typename T>
+std::vector<T> parallel_bfs(const Graph<T>& graph, ParallelBfsContext& context, const T& start, const T& end,
+                            unsigned num_threads, ParallelBfsStats* stats) {
+    constexpr uint32_t none = Graph<T>::npos_index;
+    // Пороги перемикання напрямку з оригінальної статті
+    constexpr size_t alpha = 14;
+    constexpr size_t beta = 24;
+
+    const uint32_t s = graph.node_index(start);
+    const uint32_t e = graph.node_index(end);
+    if (s == none) throw std::runtime_error("Start node does not exist");
+    if (e == none) throw std::runtime_error("End node does not exist");
+
+    if (stats) *stats = ParallelBfsStats();
+    if (s == e) return { start };
+
+    const unsigned threads = resolve_thread_count(num_threads);
+    const size_t n = graph.size();
+    context.prepare(n, threads);
+
+    std::vector<uint32_t>& level_of = context.level_of_;
+    std::vector<uint32_t>& parent = context.parent_;
+    std::vector<uint32_t>& frontier_pos = context.frontier_pos_;
+    std::atomic<uint32_t>* claim = context.claim_.get();
+    std::vector<std::vector<uint32_t>>& local_next = context.local_next_;
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>>& local_found = context.local_found_;
+    std::vector<uint32_t>& frontier = context.frontier_;
+    std::vector<uint32_t>& next = context.next_;
+
+    context.visit(s, s, 0, 0);
+    frontier.push_back(s);
+
+    size_t unexplored_edges = graph.num_edges() - graph.out_degree(s);
+    bool bottom_up = false;
+    uint32_t level = 0;
+
+    while (!frontier.empty()) {
+        // Ціль поруч із фронтом: її батько — сусід із найменшою позицією у фронті,
+        // тож останній (найбільший) рівень можна не розкривати
+        uint32_t end_pos = none;
+        uint32_t end_parent = none;
+        graph.for_each_incoming_index(e, [&](uint32_t u) {
+            if (level_of[u] == level && frontier_pos[u] < end_pos) {
+                end_pos = frontier_pos[u];
+                end_parent = u;
+            }
+        });
+        if (end_parent != none) {
+            context.visit(e, end_parent, level + 1, 0);
+            break;
+        }
+
+        size_t frontier_edges = 0;
+        for (uint32_t u : frontier) frontier_edges += graph.out_degree(u);
+
+        if (!bottom_up && frontier_edges > unexplored_edges / alpha) {
+            bottom_up = true;
+        } else if (bottom_up && frontier.size() < n / beta) {
+            bottom_up = false;
+        }
+
+        next.clear();
+        if (!bottom_up) {
+            if (stats) ++stats->top_down_levels;
+
+            // 1) кожен невідвіданий сусід запам'ятовує найменшу позицію батька у фронті
+            parallel_for(frontier.size(), threads, [&](size_t begin, size_t finish, unsigned) {
+                for (size_t i = begin; i < finish; ++i) {
+                    const uint32_t pos = static_cast<uint32_t>(i);
+                    graph.for_each_neighbor_index(frontier[i], [&](uint32_t v, graph_weight_t) {
+                        if (level_of[v] != none) return;
+                        uint32_t current = claim[v].load(std::memory_order_relaxed);
+                        while (pos < current &&
+                               !claim[v].compare_exchange_weak(current, pos, std::memory_order_relaxed)) {
+                        }
+                    });
+                }
+            });
+
+            // 2) вузол забирає той батько, що виграв, — у порядку своїх сусідів.
+            // Буфери чистяться тут: на малому фронті parallel_for викликає лише шматок 0
+            for (auto& out : local_next) out.clear();
+            parallel_for(frontier.size(), threads, [&](size_t begin, size_t finish, unsigned t) {
+                auto& out = local_next[t];
+                for (size_t i = begin; i < finish; ++i) {
+                    const uint32_t u = frontier[i];
+                    graph.for_each_neighbor_index(u, [&](uint32_t v, graph_weight_t) {
+                        if (level_of[v] == none && claim[v].load(std::memory_order_relaxed) == i) {
+                            parent[v] = u;
+                            out.push_back(v);
+                        }
+                    });
+                }
+            });
+
+            for (unsigned t = 0; t < threads; ++t) {
+                next.insert(next.end(), local_next[t].begin(), local_next[t].end());
+            }
+        } else {
+            if (stats) ++stats->bottom_up_levels;
+
+            // Кожен невідвіданий вузол шукає серед вхідних ребер батька з найменшою позицією у фронті
+            for (auto& out : local_found) out.clear();
+            parallel_for(n, threads, [&](size_t begin, size_t finish, unsigned t) {
+                auto& out = local_found[t];
+                for (size_t i = begin; i < finish; ++i) {
+                    if (level_of[i] != none) continue;
+                    uint32_t best_pos = none;
+                    uint32_t best_parent = none;
+                    graph.for_each_incoming_index(static_cast<uint32_t>(i), [&](uint32_t u) {
+                        if (level_of[u] == level && frontier_pos[u] < best_pos) {
+                            best_pos = frontier_pos[u];
+                            best_parent = u;
+                        }
+                    });
+                    if (best_parent != none) {
+                        parent[i] = best_parent;
+                        out.emplace_back(best_pos, static_cast<uint32_t>(i));
+                    }
+                }
+            });
+
+            // Порядок черги — за позицією батька у фронті, далі за id (шматки вже йдуть
+            // за зростанням id): стійке сортування підрахунком, O(знайдених + фронт)
+            std::vector<uint32_t>& slot = context.slot_;
+            slot.assign(frontier.size() + 1, 0);
+            for (unsigned t = 0; t < threads; ++t) {
+                for (const auto& entry : local_found[t]) ++slot[entry.first + 1];
+            }
+            for (size_t i = 1; i < slot.size(); ++i) slot[i] += slot[i - 1];
+            next.resize(slot.back());
+            for (unsigned t = 0; t < threads; ++t) {
+                for (const auto& entry : local_found[t]) next[slot[entry.first]++] = entry.second;
+            }
+        }
+
+        ++level;
+        parallel_for(next.size(), threads, [&](size_t begin, size_t finish, unsigned) {
+            for (size_t i = begin; i < finish; ++i) {
+                level_of[next[i]] = level;
+                frontier_pos[next[i]] = static_cast<uint32_t>(i);
+            }
+        });
+        context.touched_.insert(context.touched_.end(), next.begin(), next.end());
+        for (uint32_t v : next) unexplored_edges -= graph.out_degree(v);
+        frontier.swap(next);
+    }
+
+    std::vector<T> path;
+    if (level_of[e] != none) {
+        path.reserve(level_of[e] + 1);
+        for (uint32_t v = e; v != s; v = parent[v]) {
+            path.push_back(graph.node_at(v));
+        }
+        path.push_back(start);
+        std::reverse(path.begin(), path.end());
+    }
+    context.reset(threads);
+    return path;
+}
+
+// Разовий запит з тимчасовим робочим простором
+template <typename T>
+std::vector<T> parallel_bfs(const Graph<T>& graph, const T& start, const T& end,
+                            unsigned num_threads = 0, ParallelBfsStats* stats = nullptr) {
+    ParallelBfsContext context;
+    return parallel_bfs(graph, context, start, end, num_threads, stats);
+}
+
+#endif // PARALLELBFS_HPP
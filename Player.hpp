@@ -34,7 +34,7 @@ public:
         }
         else {
             for (size_t i = 0; i < inventory_.size(); ++i) {
-                list.push_back(std::to_string(i + 1) + ". " + inventory_[i]->get_name());
+                list.push_back(std::to_string(i + 1) + ". " + std::string(inventory_[i]->get_name()));
             }
         }
         return list;
@@ -47,6 +47,10 @@ public:
         return nullptr;
     }
 
+    const Item* get_item(size_t index) const {
+        return index < inventory_.size() ? inventory_[index] : nullptr;
+    }
+
     void remove_item(size_t index) {
         if (index < inventory_.size()) {
             inventory_.erase(inventory_.begin() + index);
@@ -10,20 +10,25 @@ private:
     int heal_amount_;
 
 public:
-    Potion(const std::string& name, const std::string& description, int heal_amount)
+    Potion(std::string_view name, std::string_view description, int heal_amount)
         : Item(name, description), heal_amount_(heal_amount) {}
 
     int get_heal_amount() const { return heal_amount_; }
 
+    ItemKind get_item_kind() const override { return ItemKind::Potion; }
+    int get_value() const override { return heal_amount_; }
+
     std::string use(Character* character) override {
         if (character == nullptr) {
             return "Помилка: Невалідний персонаж!";
         }
 
-        std::string heal_log = character->heal(heal_amount_);
+        int healed = character->heal(heal_amount_);
 
-        // ВИПРАВЛЕНО ТУТ: замінили << на +
-        return "🧪 " + character->get_name() + " використовує " + name_ + "! " + heal_log;
+        // Предмети використовуються рідко, тож текст формуємо одразу
+        return "🧪 " + character->get_name() + " використовує " + std::string(name_) + "! " +
+            character->get_name() + " відновлює " + std::to_string(healed) + " HP. (HP: " +
+            std::to_string(character->get_hp()) + "/" + std::to_string(character->get_max_hp()) + ")";
     }
 
     std::string get_info_string() const override {
@@ -0,0 +1,113 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <utility>
+
+// Швидкий генератор xoshiro256** (Blackman, Vigna) зі станом на екземпляр.
+// Замість глобального std::rand: кожна гра має власний Rng, тож паралельні
+// симуляції не ділять прихований стан, а однакове зерно дає біт-у-біт той самий
+// забіг на будь-якій платформі (жодних std::*_distribution, поведінка яких
+// залежить від стандартної бібліотеки).
+class Rng {
+private:
+    uint64_t state_[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    using result_type = uint64_t;
+
+    // splitmix64 — розгортання зерна в стан і перемішування лічильників
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Лічильникове (counter-based) зерно: залежить лише від (seed, stream, index).
+    // Rng(stream_seed(...)) для кожного елемента дає незалежні потоки, які можна
+    // роздати будь-яким потокам виконання — результат не залежить від розбиття.
+    static uint64_t stream_seed(uint64_t seed, uint64_t stream, uint64_t index) {
+        uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03ull);
+        uint64_t key = splitmix64(x);
+        x = key ^ (index * 0x8CB92BA72F3D8DD7ull);
+        return splitmix64(x);
+    }
+
+    // Незалежне від попередніх викликів зерно (для ігор, які не треба відтворювати)
+    static uint64_t random_seed() {
+        std::random_device rd;
+        return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+    }
+
+    explicit Rng(uint64_t seed = 0) { reseed(seed); }
+
+    void reseed(uint64_t seed) {
+        for (auto& word : state_) {
+            word = splitmix64(seed);
+        }
+    }
+
+    // Повний стан генератора (для збереження гри): set_state(get_state()) продовжує
+    // ту саму послідовність
+    std::array<uint64_t, 4> get_state() const {
+        return { state_[0], state_[1], state_[2], state_[3] };
+    }
+
+    void set_state(const std::array<uint64_t, 4>& state) {
+        for (size_t i = 0; i < state.size(); ++i) state_[i] = state[i];
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        const uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+    // Рівномірне число в [0, bound): множення замість ділення з відкиданням
+    // зміщених значень (Lemire). Ділення лише тоді, коли молодша половина добутку
+    // менша за bound, повтор — з імовірністю < bound / 2^32. below(0) повертає 0
+    // і не зсуває стан (напр. кількість виходів ізольованої кімнати)
+    uint32_t below(uint32_t bound) {
+        if (bound == 0) return 0;
+        uint64_t product = (next() >> 32) * bound;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < bound) {
+            const uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = (next() >> 32) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    // Сумісність з UniformRandomBitGenerator
+    uint64_t operator()() { return next(); }
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return std::numeric_limits<uint64_t>::max(); }
+};
+
+// Тасування Фішера-Єйтса на Rng (std::shuffle не гарантує однаковий результат
+// між стандартними бібліотеками)
+template <typename Container>
+void shuffle_with(Container& items, Rng& rng) {
+    for (size_t i = items.size(); i > 1; --i) {
+        size_t j = rng.below(static_cast<uint32_t>(i));
+        std::swap(items[i - 1], items[j]);
+    }
+}
+
+#endif // RANDOM_HPP
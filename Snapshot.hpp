@@ -0,0 +1,540 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DUNGEON_HAS_MMAP 1
+#endif
+
+#include "GameEngine.hpp"
+#include "GameMap.hpp"
+#include "NameTables.hpp"
+
+// Бінарний знімок гри: кімнати, CSR-ребра, вороги, предмети, гравець і поточна кімната.
+//
+// Файл — заголовок фіксованого розміру і секції масивів POD-записів (little-endian,
+// кожна секція вирівняна на 8 байт). Заголовок містить зсув і кількість записів
+// кожної секції; CSR-масиви графа записуються як є.
+//
+// Завантаження — звичайна десеріалізація, а не робота з файлом на місці: кожен запис
+// перевіряється (файл ненадійний), CSR-масиви копіюються і перевіряються знову
+// в Graph::assign_csr, вороги й предмети створюються заново через фабрики GameMap.
+// Відображення файлу (mmap) лише замінює читання в буфер і після завантаження
+// не тримається — виграш від нього невеликий, основний час іде на побудову карти.
+//
+// Версія формату змінюється при будь-якій зміні записів; старі файли відкидаються.
+// Журнал бою не зберігається. Ваги ребер графа карти завжди 1, тому не пишуться.
+
+namespace snapshot_format {
+
+constexpr char magic[8] = { 'D', 'N', 'G', 'S', 'N', 'A', 'P', '\0' };
+constexpr uint32_t version = 1;
+
+enum : uint32_t {
+    has_engine_flag = 1,     // Є гравець і стан GameEngine
+    symmetric_graph_flag = 2 // Граф неорієнтований (звіряється з графом при завантаженні)
+};
+
+struct Section {
+    uint64_t offset;  // Від початку файлу
+    uint64_t count;   // Записів
+};
+
+struct RoomRecord {
+    uint32_t enemy;    // Індекс в enemies або MapNode::no_index
+    uint32_t item;     // Індекс в items або MapNode::no_index
+    uint8_t type;      // names::room_types
+    uint8_t feature;   // names::room_features
+    uint8_t reserved[2];
+};
+
+struct FighterRecord {
+    uint8_t kind;      // CombatKind
+    uint8_t reserved[3];
+    int32_t hp;
+    int32_t attack;
+    int32_t defense;
+};
+
+struct ItemRecord {
+    uint8_t kind;      // ItemKind
+    uint8_t name;      // Індекс у names::*_names відповідного виду
+    uint8_t reserved[2];
+    int32_t value;
+};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t file_size;
+
+    Section rooms;        // RoomRecord
+    Section offsets;      // uint32_t, rooms + 1
+    Section neighbors;    // uint32_t
+    Section enemies;      // FighterRecord
+    Section items;        // ItemRecord
+    Section inventory;    // uint32_t — індекси в items
+    Section player_name;  // Байти UTF-8
+
+    FighterRecord player;
+    uint64_t seed;
+    uint64_t rng_state[4];
+    int32_t current_room;
+    int32_t final_room;
+    uint8_t running;
+    uint8_t reserved[7];
+};
+
+static_assert(sizeof(RoomRecord) == 12, "RoomRecord layout");
+static_assert(sizeof(FighterRecord) == 16, "FighterRecord layout");
+static_assert(sizeof(ItemRecord) == 8, "ItemRecord layout");
+static_assert(sizeof(Header) % 8 == 0, "Header must keep sections aligned");
+static_assert(std::is_trivially_copyable<Header>::value, "Header must be POD");
+
+} // namespace snapshot_format
+
+// Джерело байтів знімка на час завантаження: файл, відображений у пам'ять лише для
+// читання, або (де mmap немає чи use_mmap == false) прочитаний у буфер — формат той самий.
+class MappedFile {
+private:
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector<unsigned char> buffer_;
+
+    void read_into_buffer(const std::string& path) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) throw std::runtime_error("Cannot open snapshot: " + path);
+        const std::streamoff size = in.tellg();
+        buffer_.resize(static_cast<size_t>(size));
+        in.seekg(0);
+        if (size > 0 && !in.read(reinterpret_cast<char*>(buffer_.data()), size)) {
+            throw std::runtime_error("Cannot read snapshot: " + path);
+        }
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+    }
+
+public:
+    explicit MappedFile(const std::string& path, bool use_mmap = true) {
+#ifdef DUNGEON_HAS_MMAP
+        if (use_mmap) {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) throw std::runtime_error("Cannot open snapshot: " + path);
+            struct stat info;
+            if (::fstat(fd, &info) != 0) {
+                ::close(fd);
+                throw std::runtime_error("Cannot stat snapshot: " + path);
+            }
+            size_ = static_cast<size_t>(info.st_size);
+            if (size_ > 0) {
+                void* memory = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (memory == MAP_FAILED) {
+                    ::close(fd);
+                    throw std::runtime_error("Cannot map snapshot: " + path);
+                }
+                data_ = static_cast<const unsigned char*>(memory);
+                mapped_ = true;
+            }
+            ::close(fd); // Відображення лишається дійсним і без дескриптора
+            return;
+        }
+#endif
+        (void)use_mmap;
+        read_into_buffer(path);
+    }
+
+    ~MappedFile() {
+#ifdef DUNGEON_HAS_MMAP
+        if (mapped_) ::munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool is_mapped() const { return mapped_; }
+};
+
+// Доступ до внутрішнього стану GameMap і GameEngine (обидва оголошують його другом).
+// Напряму зручніше save_snapshot / load_snapshot нижче.
+struct SnapshotAccess {
+    static void check_host() {
+        const uint32_t probe = 1;
+        unsigned char first = 0;
+        std::memcpy(&first, &probe, 1);
+        if (first != 1) throw std::runtime_error("Snapshot format requires a little-endian host");
+    }
+
+    static uint64_t align8(uint64_t offset) { return (offset + 7) & ~uint64_t(7); }
+
+    // Розкладка секцій у файлі; повертає кінець останньої
+    static uint64_t layout(snapshot_format::Header& header) {
+        using namespace snapshot_format;
+        uint64_t offset = sizeof(Header);
+        auto place = [&offset](Section& section, uint64_t count, size_t record_size) {
+            offset = align8(offset);
+            section.offset = offset;
+            section.count = count;
+            offset += count * record_size;
+        };
+        place(header.rooms, header.rooms.count, sizeof(RoomRecord));
+        place(header.offsets, header.offsets.count, sizeof(uint32_t));
+        place(header.neighbors, header.neighbors.count, sizeof(uint32_t));
+        place(header.enemies, header.enemies.count, sizeof(FighterRecord));
+        place(header.items, header.items.count, sizeof(ItemRecord));
+        place(header.inventory, header.inventory.count, sizeof(uint32_t));
+        place(header.player_name, header.player_name.count, 1);
+        return align8(offset);
+    }
+
+    static void write_at(std::ofstream& out, uint64_t offset, const void* data, size_t bytes) {
+        if (bytes == 0) return;
+        out.seekp(static_cast<std::streamoff>(offset));
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    }
+
+    static snapshot_format::FighterRecord fighter_record(const Character& character) {
+        snapshot_format::FighterRecord record{};
+        record.kind = static_cast<uint8_t>(character.get_combat_kind());
+        record.hp = character.get_hp();
+        record.attack = character.get_attack_power();
+        record.defense = character.get_defense();
+        return record;
+    }
+
+    static uint8_t item_name_index(const Item& item) {
+        auto find = [&item](const auto& table) {
+            for (size_t i = 0; i < table.size(); ++i) {
+                if (table[i] == item.get_name()) return static_cast<uint8_t>(i);
+            }
+            throw std::runtime_error("Item name is not in the name tables");
+        };
+        switch (item.get_item_kind()) {
+        case ItemKind::Weapon: return find(names::weapon_names);
+        case ItemKind::Armor: return find(names::armor_names);
+        default: return find(names::potion_names);
+        }
+    }
+
+    static void save(const GameMap& map, const GameEngine* engine, const std::string& path) {
+        using namespace snapshot_format;
+        check_host();
+
+        const std::vector<uint32_t>& offsets = map.graph_.csr_offsets();
+        const std::vector<uint32_t>& neighbors = map.graph_.csr_neighbors();
+
+        std::vector<RoomRecord> rooms(map.nodes_.size());
+        for (size_t id = 0; id < rooms.size(); ++id) {
+            const MapNode& node = map.nodes_[id];
+            rooms[id] = RoomRecord{ node.get_enemy_index(), node.get_item_index(), node.get_type(), node.get_feature(), {} };
+        }
+
+        std::vector<FighterRecord> enemies;
+        enemies.reserve(map.enemies_.size());
+        for (const auto& enemy : map.enemies_) enemies.push_back(fighter_record(*enemy));
+
+        std::vector<ItemRecord> items;
+        items.reserve(map.items_.size());
+        std::unordered_map<const Item*, uint32_t> item_index;
+        for (const auto& item : map.items_) {
+            item_index.emplace(item.get(), static_cast<uint32_t>(items.size()));
+            items.push_back(ItemRecord{ static_cast<uint8_t>(item->get_item_kind()), item_name_index(*item),
+                                        {}, item->get_value() });
+        }
+
+        Header header{};
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.version = version;
+        if (map.graph_.is_symmetric()) header.flags |= symmetric_graph_flag;
+        header.rooms.count = rooms.size();
+        header.offsets.count = offsets.size();
+        header.neighbors.count = neighbors.size();
+        header.enemies.count = enemies.size();
+        header.items.count = items.size();
+
+        std::vector<uint32_t> inventory;
+        std::string player_name;
+        if (engine && engine->player_) {
+            const Player& player = *engine->player_;
+            for (size_t i = 0; i < player.inventory_size(); ++i) {
+                auto it = item_index.find(player.get_item(i));
+                if (it == item_index.end()) throw std::runtime_error("Inventory item is not part of the map");
+                inventory.push_back(it->second);
+            }
+            player_name = player.get_name();
+
+            header.flags |= has_engine_flag;
+            header.player = fighter_record(player);
+            header.seed = engine->seed_;
+            std::array<uint64_t, 4> state = engine->rng_.get_state();
+            for (size_t i = 0; i < state.size(); ++i) header.rng_state[i] = state[i];
+            header.current_room = engine->current_room_id_;
+            header.final_room = engine->final_room_id_;
+            header.running = engine->game_running_ ? 1 : 0;
+        }
+        header.inventory.count = inventory.size();
+        header.player_name.count = player_name.size();
+        header.file_size = layout(header);
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("Cannot create snapshot: " + path);
+        write_at(out, 0, &header, sizeof(header));
+        write_at(out, header.rooms.offset, rooms.data(), rooms.size() * sizeof(RoomRecord));
+        write_at(out, header.offsets.offset, offsets.data(), offsets.size() * sizeof(uint32_t));
+        write_at(out, header.neighbors.offset, neighbors.data(), neighbors.size() * sizeof(uint32_t));
+        write_at(out, header.enemies.offset, enemies.data(), enemies.size() * sizeof(FighterRecord));
+        write_at(out, header.items.offset, items.data(), items.size() * sizeof(ItemRecord));
+        write_at(out, header.inventory.offset, inventory.data(), inventory.size() * sizeof(uint32_t));
+        write_at(out, header.player_name.offset, player_name.data(), player_name.size());
+        // Добиваємо файл до file_size (вирівнювання хвоста)
+        out.seekp(static_cast<std::streamoff>(header.file_size - 1));
+        out.put('\0');
+        if (!out) throw std::runtime_error("Cannot write snapshot: " + path);
+    }
+
+    static snapshot_format::Header read_header(const MappedFile& file) {
+        using namespace snapshot_format;
+        check_host();
+
+        Header header;
+        if (file.size() < sizeof(Header)) throw std::runtime_error("Snapshot is truncated");
+        std::memcpy(&header, file.data(), sizeof(Header));
+        if (std::memcmp(header.magic, magic, sizeof(magic)) != 0) throw std::runtime_error("Not a dungeon snapshot");
+        if (header.version != version) throw std::runtime_error("Unsupported snapshot version");
+        if (header.file_size != file.size()) throw std::runtime_error("Snapshot size mismatch");
+
+        const Section* sections[] = { &header.rooms, &header.offsets, &header.neighbors, &header.enemies,
+                                      &header.items, &header.inventory, &header.player_name };
+        const size_t record_sizes[] = { sizeof(RoomRecord), sizeof(uint32_t), sizeof(uint32_t),
+                                        sizeof(FighterRecord), sizeof(ItemRecord), sizeof(uint32_t), 1 };
+        for (size_t i = 0; i < 7; ++i) {
+            const Section& section = *sections[i];
+            if (section.offset % 8 != 0 || section.offset > file.size() ||
+                section.count > (file.size() - section.offset) / record_sizes[i]) {
+                throw std::runtime_error("Snapshot section is out of bounds");
+            }
+        }
+        if (header.rooms.count >= std::numeric_limits<uint32_t>::max() ||
+            header.offsets.count != header.rooms.count + 1) {
+            throw std::runtime_error("Invalid snapshot room count");
+        }
+        return header;
+    }
+
+    template <typename Record>
+    static Record record_at(const MappedFile& file, const snapshot_format::Section& section, size_t index) {
+        Record record;
+        std::memcpy(&record, file.data() + section.offset + index * sizeof(Record), sizeof(Record));
+        return record;
+    }
+
+    template <typename Value>
+    static std::vector<Value> copy_array(const MappedFile& file, const snapshot_format::Section& section) {
+        std::vector<Value> values(static_cast<size_t>(section.count));
+        if (!values.empty()) std::memcpy(values.data(), file.data() + section.offset, values.size() * sizeof(Value));
+        return values;
+    }
+
+    static void apply_stats(Character& character, const snapshot_format::FighterRecord& record) {
+        character.modify_attack_power(record.attack - character.get_attack_power());
+        character.modify_defense(record.defense - character.get_defense());
+        character.set_hp(record.hp);
+    }
+
+    // Перевіряє записи ворогів, предметів, кімнат та інвентаря, нічого не створюючи.
+    // Кожен ворог і предмет належить щонайбільше одному місцю: інакше один ворог
+    // рахувався б живим двічі й лишався в другій кімнаті вже мертвим
+    static void check_records(const MappedFile& file, const snapshot_format::Header& header) {
+        using namespace snapshot_format;
+        for (size_t i = 0; i < header.enemies.count; ++i) {
+            const auto kind = static_cast<CombatKind>(record_at<FighterRecord>(file, header.enemies, i).kind);
+            if (kind != CombatKind::Goblin && kind != CombatKind::Orc && kind != CombatKind::Wraith) {
+                throw std::runtime_error("Invalid enemy kind in snapshot");
+            }
+        }
+
+        for (size_t i = 0; i < header.items.count; ++i) {
+            ItemRecord record = record_at<ItemRecord>(file, header.items, i);
+            size_t table_size = 0;
+            switch (static_cast<ItemKind>(record.kind)) {
+            case ItemKind::Weapon: table_size = names::weapon_names.size(); break;
+            case ItemKind::Armor: table_size = names::armor_names.size(); break;
+            case ItemKind::Potion: table_size = names::potion_names.size(); break;
+            default: throw std::runtime_error("Invalid item kind in snapshot");
+            }
+            if (record.name >= table_size) throw std::runtime_error("Invalid item name in snapshot");
+        }
+
+        std::vector<bool> enemy_used(static_cast<size_t>(header.enemies.count), false);
+        std::vector<bool> item_used(static_cast<size_t>(header.items.count), false);
+        for (size_t id = 0; id < header.rooms.count; ++id) {
+            RoomRecord record = record_at<RoomRecord>(file, header.rooms, id);
+            if (record.type >= names::room_types.size() || record.feature >= names::room_features.size() ||
+                (record.enemy != MapNode::no_index && (record.enemy >= header.enemies.count || enemy_used[record.enemy])) ||
+                (record.item != MapNode::no_index && (record.item >= header.items.count || item_used[record.item]))) {
+                throw std::runtime_error("Invalid room in snapshot");
+            }
+            if (record.enemy != MapNode::no_index) enemy_used[record.enemy] = true;
+            if (record.item != MapNode::no_index) item_used[record.item] = true;
+        }
+
+        // Підібраний предмет лежить лише в інвентарі — не в кімнаті й не двічі
+        for (size_t i = 0; i < header.inventory.count; ++i) {
+            const uint32_t item = record_at<uint32_t>(file, header.inventory, i);
+            if (item >= header.items.count || item_used[item]) {
+                throw std::runtime_error("Invalid inventory item in snapshot");
+            }
+            item_used[item] = true;
+        }
+    }
+
+    // Граф карти з CSR-секцій: assign_csr перевіряє масиви й сам визначає
+    // симетричність, а прапорець файлу має з нею збігатися
+    static Graph<uint32_t> load_graph(const MappedFile& file, const snapshot_format::Header& header) {
+        using namespace snapshot_format;
+        std::vector<uint32_t> ids(static_cast<size_t>(header.rooms.count));
+        for (size_t id = 0; id < ids.size(); ++id) ids[id] = static_cast<uint32_t>(id);
+
+        Graph<uint32_t> graph;
+        graph.assign_csr(std::move(ids), copy_array<uint32_t>(file, header.offsets),
+                         copy_array<uint32_t>(file, header.neighbors));
+        if (graph.is_symmetric() != ((header.flags & symmetric_graph_flag) != 0)) {
+            throw std::runtime_error("Snapshot graph symmetry flag mismatch");
+        }
+        return graph;
+    }
+
+    // Заповнює карту з уже перевірених записів (check_records, load_graph)
+    static void build_map(GameMap& map, const MappedFile& file, const snapshot_format::Header& header,
+                          Graph<uint32_t> graph) {
+        using namespace snapshot_format;
+        const size_t num_rooms = static_cast<size_t>(header.rooms.count);
+        const size_t num_enemies = static_cast<size_t>(header.enemies.count);
+        const size_t num_items = static_cast<size_t>(header.items.count);
+
+        map.reset(static_cast<int>(num_rooms), static_cast<int>(num_enemies), static_cast<int>(num_items));
+
+        for (size_t i = 0; i < num_enemies; ++i) {
+            FighterRecord record = record_at<FighterRecord>(file, header.enemies, i);
+            map.enemies_.push_back(map.make_enemy(static_cast<CombatKind>(record.kind)));
+            apply_stats(*map.enemies_.back(), record);
+        }
+
+        for (size_t i = 0; i < num_items; ++i) {
+            ItemRecord record = record_at<ItemRecord>(file, header.items, i);
+            map.items_.push_back(map.make_item(static_cast<ItemKind>(record.kind), record.name, record.value));
+        }
+
+        for (size_t id = 0; id < num_rooms; ++id) {
+            RoomRecord record = record_at<RoomRecord>(file, header.rooms, id);
+            MapNode node(static_cast<uint32_t>(id), record.type, record.feature);
+            node.set_enemy_index(record.enemy);
+            node.set_item_index(record.item);
+            map.nodes_.push_back(node);
+
+            // Живі вороги — ті, що ще стоять у кімнатах
+            if (record.enemy != MapNode::no_index) {
+                ++map.live_enemies_;
+                ++map.live_by_kind_[static_cast<size_t>(map.enemies_[record.enemy]->get_combat_kind())];
+            }
+        }
+
+        map.graph_ = std::move(graph);
+    }
+
+    static void load(GameMap& map, const std::string& path, bool use_mmap) {
+        MappedFile file(path, use_mmap);
+        const snapshot_format::Header header = read_header(file);
+        check_records(file, header);
+        build_map(map, file, header, load_graph(file, header));
+    }
+
+    static void load(GameEngine& engine, const std::string& path, bool use_mmap) {
+        using namespace snapshot_format;
+        MappedFile file(path, use_mmap);
+        const Header header = read_header(file);
+        if (!(header.flags & has_engine_flag)) throw std::runtime_error("Snapshot has no game state");
+        if (header.current_room < 0 || static_cast<uint64_t>(header.current_room) >= header.rooms.count ||
+            header.final_room < 0 || static_cast<uint64_t>(header.final_room) >= header.rooms.count) {
+            throw std::runtime_error("Invalid room id in snapshot");
+        }
+        const auto player_kind = static_cast<CombatKind>(header.player.kind);
+        if (player_kind != CombatKind::Warrior && player_kind != CombatKind::Mage &&
+            player_kind != CombatKind::Archer) {
+            throw std::runtime_error("Invalid player class in snapshot");
+        }
+        check_records(file, header);
+        Graph<uint32_t> graph = load_graph(file, header);
+
+        // Файл перевірено повністю: лише тепер поточна гра знищується.
+        // Інвентар гравця вказує на предмети карти, тож спершу гравець, потім карта
+        engine.game_running_ = false;
+        engine.player_.reset();
+        engine.dungeon_ = std::make_unique<GameMap>();
+        build_map(*engine.dungeon_, file, header, std::move(graph));
+
+        std::string name(reinterpret_cast<const char*>(file.data() + header.player_name.offset),
+                         static_cast<size_t>(header.player_name.count));
+        switch (player_kind) {
+        case CombatKind::Mage: engine.player_ = std::make_unique<Mage>(name); break;
+        case CombatKind::Archer: engine.player_ = std::make_unique<Archer>(name, &engine.rng_); break;
+        default: engine.player_ = std::make_unique<Warrior>(name); break;
+        }
+        apply_stats(*engine.player_, header.player);
+        for (size_t i = 0; i < header.inventory.count; ++i) {
+            engine.player_->add_item(engine.dungeon_->items_[record_at<uint32_t>(file, header.inventory, i)].get());
+        }
+
+        engine.combat_log_.clear();
+        engine.player_->attach_combat_log(&engine.combat_log_);
+        engine.seed_ = header.seed;
+        engine.rng_.set_state({ header.rng_state[0], header.rng_state[1], header.rng_state[2], header.rng_state[3] });
+        engine.current_room_id_ = header.current_room;
+        engine.final_room_id_ = header.final_room;
+        engine.game_running_ = header.running != 0;
+    }
+};
+
+// Зберігає лише карту (без гравця)
+inline void save_snapshot(const GameMap& map, const std::string& path) {
+    SnapshotAccess::save(map, nullptr, path);
+}
+
+// Зберігає всю гру; гра має бути розпочата
+inline void save_snapshot(const GameEngine& engine, const std::string& path) {
+    if (!engine.get_map()) throw std::runtime_error("Game is not started");
+    SnapshotAccess::save(*engine.get_map(), &engine, path);
+}
+
+// Завантажує карту з будь-якого знімка. use_mmap == false — читання у буфер
+// замість відображення (той самий результат, для порівняння й платформ без mmap).
+inline void load_snapshot(GameMap& map, const std::string& path, bool use_mmap = true) {
+    SnapshotAccess::load(map, path, use_mmap);
+}
+
+// Відновлює гру зі знімка save_snapshot(engine); слухачеві подій нічого не надсилається
+inline void load_snapshot(GameEngine& engine, const std::string& path, bool use_mmap = true) {
+    SnapshotAccess::load(engine, path, use_mmap);
+}
+
+#endif // SNAPSHOT_HPP
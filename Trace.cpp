@@ -0,0 +1,148 @@
+#include "Trace.hpp"
+
+#ifdef DUNGEON_TRACING
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace tracing {
+
+namespace {
+
+struct Event {
+    const char* name;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+};
+
+// Кільцевий буфер одного потоку. Пише лише власник; written — скільки подій
+// записано за весь час (індекс у кільці — written % events_per_thread).
+// Події не ініціалізуються: сторінки пам'яті займаються лише тоді, коли в них пишуть.
+struct ThreadBuffer {
+    uint32_t thread_id = 0;
+    bool in_use = false; // Має власника (під registry_mutex)
+    std::unique_ptr<Event[]> events{ new Event[events_per_thread] };
+    std::atomic<uint64_t> written{ 0 };
+};
+
+// Буфери живуть до кінця програми, щоб події завершених потоків теж експортувалися.
+// Буфер завершеного потоку дістається наступному новому потоку разом зі старими
+// подіями й tid, тож буферів стільки, скільки потоків писали одночасно, а не
+// скільки їх було за весь час.
+std::mutex registry_mutex;
+std::vector<std::unique_ptr<ThreadBuffer>> registry;
+
+const std::chrono::steady_clock::time_point trace_epoch = std::chrono::steady_clock::now();
+
+// Буфер потоку; повертається до вільних, коли потік завершується
+struct BufferLease {
+    ThreadBuffer* buffer = nullptr;
+
+    ~BufferLease() {
+        if (!buffer) return;
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        buffer->in_use = false;
+    }
+};
+
+thread_local BufferLease local_lease;
+
+ThreadBuffer& buffer_for_this_thread() {
+    if (!local_lease.buffer) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        for (const auto& buffer : registry) {
+            if (!buffer->in_use) {
+                local_lease.buffer = buffer.get();
+                break;
+            }
+        }
+        if (!local_lease.buffer) {
+            registry.push_back(std::make_unique<ThreadBuffer>());
+            registry.back()->thread_id = static_cast<uint32_t>(registry.size());
+            local_lease.buffer = registry.back().get();
+        }
+        local_lease.buffer->in_use = true;
+    }
+    return *local_lease.buffer;
+}
+
+// Назви — літерали коду, але лапки й керівні символи все одно екрануються
+void write_json_string(std::FILE* out, const char* text) {
+    std::fputc('"', out);
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            std::fputc('\\', out);
+            std::fputc(*c, out);
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            std::fprintf(out, "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(*c)));
+        } else {
+            std::fputc(*c, out);
+        }
+    }
+    std::fputc('"', out);
+}
+
+} // namespace
+
+uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - trace_epoch).count());
+}
+
+void record(const char* name, uint64_t start_ns, uint64_t end_ns) {
+    ThreadBuffer& buffer = buffer_for_this_thread();
+    const uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[index % events_per_thread] = Event{ name, start_ns, end_ns - start_ns };
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+size_t event_count() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    size_t count = 0;
+    for (const auto& buffer : registry) {
+        const uint64_t written = buffer->written.load(std::memory_order_acquire);
+        count += static_cast<size_t>(written < events_per_thread ? written : events_per_thread);
+    }
+    return count;
+}
+
+void clear() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (const auto& buffer : registry) {
+        buffer->written.store(0, std::memory_order_release);
+    }
+}
+
+bool write_chrome_json(const std::string& path) {
+    std::FILE* out = std::fopen(path.c_str(), "w");
+    if (!out) return false;
+
+    std::fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        for (const auto& buffer : registry) {
+            const uint64_t written = buffer->written.load(std::memory_order_acquire);
+            const uint64_t begin = written > events_per_thread ? written - events_per_thread : 0;
+            for (uint64_t i = begin; i < written; ++i) {
+                const Event& event = buffer->events[i % events_per_thread];
+                std::fprintf(out, "%s{\"name\":", first ? "" : ",\n");
+                write_json_string(out, event.name);
+                // Chrome рахує час у мікросекундах
+                std::fprintf(out, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                             buffer->thread_id, event.start_ns / 1000.0, event.duration_ns / 1000.0);
+                first = false;
+            }
+        }
+    }
+    std::fprintf(out, "\n]}\n");
+    return std::fclose(out) == 0;
+}
+
+} // namespace tracing
+
+#endif // DUNGEON_TRACING
@@ -0,0 +1,72 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Легкі маркери трасування гарячих шляхів: генерація підземелля, слоти Game,
+// MainWindow::updateUI. Вмикаються під час збирання: DEFINES += DUNGEON_TRACING
+// (qmake CONFIG+=tracing для гри) і Trace.cpp у SOURCES. Без визначення
+// DUNGEON_TRACE_SCOPE нічого не генерує.
+//
+// Подія — (назва, початок, тривалість) за steady_clock. Кожен потік пише у власний
+// кільцевий буфер фіксованого розміру (найстаріші події затираються), тож запис
+// не бере блокувань і не виділяє пам'ять після першої події потоку. Буфер
+// завершеного потоку переходить до наступного нового: пам'ять трасування обмежена
+// найбільшою кількістю потоків, що писали одночасно.
+// write_chrome_json зберігає все у форматі Chrome trace-event (chrome://tracing,
+// ui.perfetto.dev). Експортувати слід, коли потоки з маркерами не працюють.
+
+namespace tracing {
+
+// Подій на потік до того, як найстаріші почнуть затиратися
+constexpr size_t events_per_thread = size_t(1) << 16;
+
+#ifdef DUNGEON_TRACING
+
+// Наносекунди від старту трасування
+uint64_t now_ns();
+
+// name — рядок, що живе до кінця програми (літерал)
+void record(const char* name, uint64_t start_ns, uint64_t end_ns);
+
+// Скільки подій зараз у буферах усіх потоків
+size_t event_count();
+
+// Скидає буфери всіх потоків
+void clear();
+
+// Записує всі події в path як JSON Chrome trace-event; false, якщо не вдалося
+bool write_chrome_json(const std::string& path);
+
+class Scope {
+private:
+    const char* name_;
+    uint64_t start_;
+
+public:
+    explicit Scope(const char* name)
+        : name_(name), start_(now_ns()) {
+    }
+
+    ~Scope() { record(name_, start_, now_ns()); }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+#define DUNGEON_TRACE_CONCAT_INNER(a, b) a##b
+#define DUNGEON_TRACE_CONCAT(a, b) DUNGEON_TRACE_CONCAT_INNER(a, b)
+#define DUNGEON_TRACE_SCOPE(name) \
+    ::tracing::Scope DUNGEON_TRACE_CONCAT(dungeon_trace_scope_, __LINE__)(name)
+
+#else
+
+#define DUNGEON_TRACE_SCOPE(name) static_cast<void>(0)
+
+#endif // DUNGEON_TRACING
+
+} // namespace tracing
+
+#endif // TRACE_HPP
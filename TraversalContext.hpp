@@ -0,0 +1,109 @@
+#ifndef TRAVERSALCONTEXT_HPP
+#define TRAVERSALCONTEXT_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <limits>
+
+// Тип ваги ребра Graph
+using graph_weight_t = double;
+
+// Робочий простір для повторних обходів компактного Graph (bfs/dfs/dijkstra/a_star).
+// Масиви індексуються щільним id вузла. Між запитами вони не очищуються:
+// натомість збільшується лічильник епохи, тому запит на "теплому" контексті
+// не виділяє пам'яті. Один контекст — один потік.
+class TraversalContext {
+public:
+    static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+    // Бік двонаправленого пошуку, що відвідав вузол
+    static constexpr uint8_t forward_side = 0;
+    static constexpr uint8_t backward_side = 1;
+
+    // Запис бінарної купи для Dijkstra/A*: priority = cost + евристика
+    struct heap_entry {
+        graph_weight_t priority;
+        graph_weight_t cost;
+        uint32_t node;
+    };
+
+private:
+    std::vector<uint32_t> visit_epoch_;
+    std::vector<uint32_t> parent_;
+    std::vector<graph_weight_t> cost_;
+    std::vector<uint32_t> depth_;
+    std::vector<uint8_t> side_;
+    std::vector<uint32_t> pending_;
+    std::vector<uint32_t> pending_back_;
+    std::vector<heap_entry> heap_;
+    uint32_t epoch_ = 0;
+    size_t explored_ = 0;
+
+public:
+    TraversalContext() = default;
+    explicit TraversalContext(size_t num_nodes) { reserve(num_nodes); }
+
+    void reserve(size_t num_nodes) {
+        if (visit_epoch_.size() < num_nodes) {
+            visit_epoch_.resize(num_nodes, 0);
+            parent_.resize(num_nodes, none);
+            cost_.resize(num_nodes, 0);
+            depth_.resize(num_nodes, 0);
+            side_.resize(num_nodes, forward_side);
+        }
+        pending_.reserve(num_nodes);
+    }
+
+    // Починає новий запит: усі вузли знову вважаються невідвіданими
+    void begin(size_t num_nodes) {
+        reserve(num_nodes);
+        if (++epoch_ == 0) {
+            // Лічильник переповнився — один раз справді очищуємо позначки
+            std::fill(visit_epoch_.begin(), visit_epoch_.end(), 0);
+            epoch_ = 1;
+        }
+        pending_.clear();
+        pending_back_.clear();
+        heap_.clear();
+        explored_ = 0;
+    }
+
+    bool is_visited(uint32_t node) const { return visit_epoch_[node] == epoch_; }
+
+    void visit(uint32_t node, uint32_t parent) {
+        visit_epoch_[node] = epoch_;
+        parent_[node] = parent;
+    }
+
+    // Для двонаправленого пошуку: parent веде до кореня свого боку
+    void visit(uint32_t node, uint32_t parent, uint8_t side, uint32_t depth) {
+        visit(node, parent);
+        side_[node] = side;
+        depth_[node] = depth;
+    }
+
+    uint32_t parent_of(uint32_t node) const { return parent_[node]; }
+    uint8_t side_of(uint32_t node) const { return side_[node]; }
+    uint32_t depth_of(uint32_t node) const { return depth_[node]; }
+
+    // Скільки вузлів розкрив останній запит
+    void count_explored() { ++explored_; }
+    size_t explored() const { return explored_; }
+
+    // Найкраща відома вартість шляху до вузла (має сенс лише для відвіданих)
+    void set_cost(uint32_t node, graph_weight_t cost) { cost_[node] = cost; }
+    graph_weight_t cost_of(uint32_t node) const { return cost_[node]; }
+
+    // Черга (BFS) або стек (DFS) поточного запиту
+    std::vector<uint32_t>& pending() { return pending_; }
+
+    // Черга зворотного боку двонаправленого bfs
+    std::vector<uint32_t>& pending_back() { return pending_back_; }
+
+    // Купа пріоритетів Dijkstra/A* поточного запиту
+    std::vector<heap_entry>& heap() { return heap_; }
+};
+
+#endif // TRAVERSALCONTEXT_HPP
@@ -10,15 +10,16 @@ public:
         : Player(name, 150, 25, 12) {
     }
 
-    std::string attack(Character& target) override {
+    int attack(Character& target) override {
         int damage = static_cast<int>(attack_power_ * 1.2);  // 120% пошкоджень
 
-        // Викликаємо take_damage у цілі і отримуємо результат
-        std::string damage_log = target.take_damage(damage);
-
-        return "⚔️ " + name_ + " (Воїн) завдає ПОТУЖНОГО УДАРУ! " + damage_log;
+        int dealt = target.take_damage(damage);
+        record_event(CombatEventKind::PowerStrike, target, dealt);
+        return dealt;
     }
 
+    CombatKind get_combat_kind() const override { return CombatKind::Warrior; }
+
     std::string get_stats_string() const override {
         return Player::get_stats_string() + " [Клас: Воїн (+20% атаки)]";
     }
@@ -11,12 +11,15 @@ private:
     int damage_;
 
 public:
-    Weapon(const std::string& name, const std::string& description, int damage)
+    Weapon(std::string_view name, std::string_view description, int damage)
         : Item(name, description), damage_(damage) {
     }
 
     int get_damage() const { return damage_; }
 
+    ItemKind get_item_kind() const override { return ItemKind::Weapon; }
+    int get_value() const override { return damage_; }
+
     std::string use(Character* character) override {
         if (character == nullptr) {
             return "Помилка: Невалідний персонаж!";
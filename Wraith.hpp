@@ -3,7 +3,6 @@
 
 #include "Enemy.hpp"
 #include <string>
-#include <sstream>
 
 class Wraith : public Enemy {
 private:
@@ -14,40 +13,34 @@ public:
         : Enemy(name, 60, 18, 5) {
     }
 
-    std::string attack(Character& target) override {
+    int attack(Character& target) override {
         // Атака + Вампіризм
-        std::string damage_log = target.take_damage(attack_power_);
+        int dealt = target.take_damage(attack_power_);
+        record_event(CombatEventKind::Drain, target, dealt);
 
         int heal_amount = attack_power_ / 3;
-        std::string heal_log = heal(heal_amount); // Примара лікує сама себе
-
-        return "👻 " + name_ + " (Примара) використовує СПЕКТРАЛЬНЕ ВИСМОКТУВАННЯ! " +
-            damage_log + " (Примара відновила сили)";
+        heal(heal_amount); // Примара лікує сама себе
+        return dealt;
     }
 
     // Перевизначення take_damage для обробки резистів
-    std::string take_damage(int amount) override {
-        if (amount <= 0) return name_ + " не отримує пошкоджень.";
-
-        int reduced_amount = static_cast<int>(amount * physical_resistance_);
-        if (reduced_amount < 1 && amount > 0) {
-            reduced_amount = 1;
-        }
+    int take_damage(int amount) override {
+        if (amount <= 0) return 0;
 
-        // Розрахунок захисту (логіка дублюється з Character, щоб врахувати резист)
-        int actual_damage = reduced_amount - defense_;
-        if (actual_damage < 1 && reduced_amount > 0) {
-            actual_damage = 1;
-        }
+        // Спершу резист, потім захист (спільне правило з Character і CombatStore)
+        int actual_damage = damage_taken(amount, defense_, get_physical_resistance());
 
         hp_ -= actual_damage;
         if (hp_ < 0) hp_ = 0;
 
-        std::ostringstream ss;
-        ss << "👻 " << name_ << " проходить крізь атаку (50% резист)! Отримує лише "
-            << actual_damage << " шкоди. (HP: " << hp_ << "/" << max_hp_ << ")";
+        return actual_damage;
+    }
+
+    CombatKind get_combat_kind() const override { return CombatKind::Wraith; }
 
-        return ss.str();
+    // physical_resistance_ — множник шкоди, що проходить; резист — решта
+    float get_physical_resistance() const override {
+        return static_cast<float>(1.0 - physical_resistance_);
     }
 
     std::string get_stats_string() const override {
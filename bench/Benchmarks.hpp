@@ -0,0 +1,26 @@
+#ifndef BENCHMARKS_HPP
+#define BENCHMARKS_HPP
+
+#include <chrono>
+
+// Годинник усіх бенчмарків і мілісекунди від since
+using Clock = std::chrono::steady_clock;
+
+inline double elapsed_ms(Clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+}
+
+// Точки входу окремих бенчмарків (argv[0] — назва бенчмарку)
+int run_pathfinding_bench(int argc, char* argv[]);
+int run_parallel_bfs_bench(int argc, char* argv[]);
+int run_combat_simd_bench(int argc, char* argv[]);
+int run_map_arena_bench(int argc, char* argv[]);
+int run_map_memory_bench(int argc, char* argv[]);
+int run_chunked_bench(int argc, char* argv[]);
+int run_parallel_gen_bench(int argc, char* argv[]);
+int run_snapshot_bench(int argc, char* argv[]);
+int run_micro_bench(int argc, char* argv[]);
+int run_alloc_turn_bench(int argc, char* argv[]);
+int run_trace_bench(int argc, char* argv[]);
+
+#endif // BENCHMARKS_HPP
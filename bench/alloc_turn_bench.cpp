@@ -0,0 +1,93 @@
+#include "AllocTracker.hpp"
+#include "Benchmarks.hpp"
+#include "GameEngine.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+// Виділення купи за хід: бот грає ігри GameEngine, кожна дія — DUNGEON_ALLOC_ACTION.
+// Для першої гри друкуються підсумки AllocTracker по кожній дії (з розбивкою за
+// областями GameEngine / GameMap / Graph), далі — зведення за видами дій: скільки
+// ходів обійшлися без жодного виділення.
+//
+// Параметри: [ігор (типово 200)]
+
+namespace {
+
+enum ActionKind { attack_action, move_action, take_action, action_kinds };
+
+const char* const action_names[action_kinds] = { "attack", "move", "take_item" };
+
+struct ActionStats {
+    uint64_t actions = 0;
+    uint64_t allocation_free = 0;
+    uint64_t allocs = 0;
+    uint64_t bytes = 0;
+};
+
+void print_line(const char* line) {
+    std::printf("%s\n", line);
+}
+
+} // namespace
+
+int run_alloc_turn_bench(int argc, char* argv[])
+{
+#ifndef DUNGEON_ALLOC_TRACKING
+    (void)argc;
+    (void)argv;
+    std::fprintf(stderr, "Зберіть з DUNGEON_ALLOC_TRACKING (qmake CONFIG+=instrumented bench.pro)\n");
+    return 1;
+#else
+    const int games = argc > 1 ? std::atoi(argv[1]) : 200;
+    ActionStats stats[action_kinds];
+
+    for (int game = 0; game < games; ++game) {
+        // Підсумки по кожній дії — лише для першої гри
+        alloc_tracking::set_report_sink(game == 0 ? print_line : nullptr);
+        if (game == 0) std::printf("--- гра 0: підсумки AllocTracker по діях ---\n");
+
+        GameEngine engine;
+        engine.start("Бот", static_cast<PlayerClass>(game % 3), static_cast<uint64_t>(game));
+        Rng driver(static_cast<uint64_t>(game));
+
+        for (int turn = 0; engine.is_running() && turn < 10000; ++turn) {
+            ActionKind kind = move_action;
+            if (engine.get_current_enemy()) kind = attack_action;
+            else if (engine.get_current_item()) kind = take_action;
+            const size_t exits = engine.get_map()->get_num_neighbors(engine.get_current_room_id());
+            const int exit_index = static_cast<int>(driver.below(static_cast<uint32_t>(exits)));
+
+            const alloc_tracking::Counts before = alloc_tracking::totals();
+            {
+                DUNGEON_ALLOC_ACTION(action_names[kind]);
+                switch (kind) {
+                case attack_action: engine.attack(); break;
+                case take_action: engine.take_item(); break;
+                default: engine.move(exit_index); break;
+                }
+            }
+            const alloc_tracking::Counts after = alloc_tracking::totals();
+
+            ActionStats& s = stats[kind];
+            ++s.actions;
+            s.allocs += after.count - before.count;
+            s.bytes += after.bytes - before.bytes;
+            if (after.count == before.count) ++s.allocation_free;
+        }
+    }
+    alloc_tracking::set_report_sink(nullptr);
+
+    std::printf("\nігор=%d\n", games);
+    // Заголовок вирівняно вручну: printf рахує ширину в байтах, а не в літерах
+    std::printf("дія             ходів     без виділень   виділень/хід     байт/хід\n");
+    for (int kind = 0; kind < action_kinds; ++kind) {
+        const ActionStats& s = stats[kind];
+        const double actions = s.actions ? static_cast<double>(s.actions) : 1.0;
+        std::printf("%-10s %10llu %15.1f%% %14.2f %12.1f\n", action_names[kind],
+                    static_cast<unsigned long long>(s.actions), 100.0 * s.allocation_free / actions,
+                    s.allocs / actions, s.bytes / actions);
+    }
+    return 0;
+#endif
+}
@@ -0,0 +1,48 @@
+# Консольні бенчмарки без Qt: qmake bench.pro && make && ./dungeon_bench <назва>
+
+TEMPLATE = app
+TARGET = dungeon_bench
+
+CONFIG += console c++17 thread
+CONFIG -= app_bundle qt
+
+INCLUDEPATH += ..
+
+HEADERS += Benchmarks.hpp
+
+# Бенчмарки часу збираються без інструментування: підмінений operator new
+# і маркери трасування спотворили б їхні виміри. micro, alloc-turn і trace
+# потребують обліку виділень / трасування — окрема збірка в іншому каталозі:
+#   qmake CONFIG+=instrumented ../bench.pro && make && ./dungeon_bench_instrumented <назва>
+instrumented {
+    TARGET = dungeon_bench_instrumented
+    DEFINES += DUNGEON_ALLOC_TRACKING DUNGEON_TRACING DUNGEON_INSTRUMENTED_BENCH
+
+    SOURCES += \
+        main.cpp \
+        micro_bench.cpp \
+        alloc_turn_bench.cpp \
+        trace_bench.cpp \
+        ../AllocTracker.cpp \
+        ../Trace.cpp
+
+    HEADERS += \
+        ../AllocTracker.hpp \
+        ../Trace.hpp
+} else {
+    SOURCES += \
+        main.cpp \
+        pathfinding_bench.cpp \
+        parallel_bfs_bench.cpp \
+        combat_simd_bench.cpp \
+        map_arena_bench.cpp \
+        map_memory_bench.cpp \
+        chunked_bench.cpp \
+        parallel_gen_bench.cpp \
+        snapshot_bench.cpp
+
+    # make check: ядро шкоди (AVX2 і скалярне) проти take_damage; розбіжність дає ненульовий код
+    check.commands = ./$$TARGET combat-simd 100000 5
+    check.depends = $(TARGET)
+    QMAKE_EXTRA_TARGETS += check
+}
@@ -0,0 +1,146 @@
+#include "Benchmarks.hpp"
+#include "ChunkedDungeon.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <string_view>
+
+// Потокове підземелля: старт, прохід крізь багато чанків з вивантаженням
+// і перевірка, що повторно згенерований чанк збігається з оригіналом
+// (разом зі збереженими змінами — переможеними ворогами, і після повторного
+// відвідування). Окремо — світ з обмеженою кількістю дельт (max_deltas).
+//
+// Параметри: [чанків пройти (типово 10000)] [кімнат у чанку (типово 64)]
+
+namespace {
+
+size_t resident_kib() {
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    if (!(statm >> total_pages >> resident_pages)) return 0;
+    return resident_pages * 4;
+}
+
+size_t chunk_fingerprint(ChunkedDungeon& dungeon, uint64_t chunk_id) {
+    size_t hash = 0;
+    for (uint32_t room = 0; room < dungeon.get_chunk_size(); ++room) {
+        const RoomRef ref{ chunk_id, room };
+        hash = hash * 31 + std::hash<std::string_view>()(dungeon.get_room(ref)->get_description());
+        hash = hash * 31 + (dungeon.get_room(ref)->has_enemy() ? 7 : 3);
+        dungeon.for_each_neighbor(ref, [&hash](const RoomRef& neighbor) {
+            hash = hash * 31 + static_cast<size_t>(neighbor.chunk * 1000003 + neighbor.room);
+        });
+    }
+    return hash;
+}
+
+// Прохід уперед: завжди до "найдальшого" сусіда, перемагаючи ворогів на шляху.
+// Кімната i має сусіда i + 1, а остання — перехід у наступний чанк, тож шлях монотонний.
+// Повертає кількість кроків; max_loaded — найбільше чанків у пам'яті одночасно
+uint64_t walk_forward(ChunkedDungeon& dungeon, uint64_t target_chunks, size_t& max_loaded) {
+    RoomRef position{ 0, 0 };
+    dungeon.set_player_chunk(position.chunk);
+    uint64_t steps = 0;
+    while (position.chunk < target_chunks) {
+        GameMap& map = dungeon.chunk(position.chunk);
+        map.remove_enemy(*map.get_node_by_id(static_cast<int>(position.room)));
+
+        RoomRef next = position;
+        dungeon.for_each_neighbor(position, [&next](const RoomRef& neighbor) {
+            if (neighbor.chunk > next.chunk || (neighbor.chunk == next.chunk && neighbor.room > next.room)) {
+                next = neighbor;
+            }
+        });
+        position = next;
+        dungeon.set_player_chunk(position.chunk);
+        max_loaded = std::max(max_loaded, dungeon.get_loaded_chunks());
+        ++steps;
+    }
+    return steps;
+}
+
+// Обмежені дельти: тримається не більше max_deltas, і це зміни найближчих до гравця
+// чанків; далекі чанки забувають перемоги й збігаються зі свіжою генерацією
+bool bounded_deltas_hold(uint64_t seed, uint32_t chunk_size) {
+    const uint64_t target = 64;
+    const size_t max_deltas = 8;
+    const uint32_t keep_radius = ChunkedDungeon::default_keep_radius;
+    ChunkedDungeon bounded(seed, chunk_size, keep_radius, 2, max_deltas);
+    ChunkedDungeon unbounded(seed, chunk_size, keep_radius);
+    ChunkedDungeon fresh(seed, chunk_size);
+    size_t max_loaded = 0;
+    walk_forward(bounded, target, max_loaded);
+    walk_forward(unbounded, target, max_loaded);
+
+    const size_t all_deltas = unbounded.get_stored_deltas();
+    bool ok = bounded.get_stored_deltas() == std::min(all_deltas, max_deltas) &&
+              bounded.get_dropped_deltas() == all_deltas - bounded.get_stored_deltas();
+    for (uint64_t id = target - keep_radius - max_deltas; id < target - keep_radius; ++id) {
+        ok = ok && bounded.chunk(id).get_live_enemy_count() == unbounded.chunk(id).get_live_enemy_count();
+    }
+    return ok && bounded.chunk(1).get_live_enemy_count() == fresh.chunk(1).get_live_enemy_count() &&
+           unbounded.chunk(1).get_live_enemy_count() < fresh.chunk(1).get_live_enemy_count();
+}
+
+} // namespace
+
+int run_chunked_bench(int argc, char* argv[])
+{
+    const uint64_t target_chunks = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    const uint32_t chunk_size = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 64;
+    const uint64_t seed = 99;
+
+    auto t0 = Clock::now();
+    ChunkedDungeon dungeon(seed, chunk_size);
+    dungeon.set_player_chunk(0);
+    const double startup_ms = elapsed_ms(t0);
+    const size_t rss_start = resident_kib();
+
+    size_t max_loaded = 0;
+    t0 = Clock::now();
+    const uint64_t steps = walk_forward(dungeon, target_chunks, max_loaded);
+    const double walk_ms = elapsed_ms(t0);
+    const size_t rss_end = resident_kib();
+
+    const size_t deltas_after_walk = dungeon.get_stored_deltas();
+
+    // Повернення до чанка 1 і знову геть: відновлений з дельти чанк без нових змін
+    // має зберегти дельту при повторному вивантаженні
+    dungeon.set_player_chunk(1);
+    dungeon.set_player_chunk(target_chunks);
+
+    // Чанк 1 давно вивантажено: перегенерований має збігтися з новим світом з тим самим зерном,
+    // крім ворогів, переможених на шляху (їх відновлює дельта)
+    ChunkedDungeon fresh(seed, chunk_size);
+    bool layout_same = true;
+    for (uint32_t room = 0; room < chunk_size; ++room) {
+        const RoomRef ref{ 1, room };
+        layout_same &= dungeon.get_room(ref)->get_description() == fresh.get_room(ref)->get_description();
+        layout_same &= dungeon.get_num_neighbors(ref) == fresh.get_num_neighbors(ref);
+    }
+    const bool kills_kept = dungeon.chunk(1).get_live_enemy_count() < fresh.chunk(1).get_live_enemy_count();
+    ChunkedDungeon again(seed, chunk_size);
+    const bool deterministic = chunk_fingerprint(fresh, target_chunks / 2) == chunk_fingerprint(again, target_chunks / 2);
+    const bool bounded = bounded_deltas_hold(seed, chunk_size);
+
+    std::printf("чанків=%llu кімнат у чанку=%u (усього %llu кімнат)\n",
+                static_cast<unsigned long long>(target_chunks), chunk_size,
+                static_cast<unsigned long long>(target_chunks * chunk_size));
+    std::printf("старт            %9.3f ms\n", startup_ms);
+    std::printf("прохід           %9.2f ms  (%llu кроків, %.2f us/крок)\n", walk_ms,
+                static_cast<unsigned long long>(steps), steps ? walk_ms * 1000.0 / steps : 0.0);
+    std::printf("згенеровано      %llu чанків, одночасно в пам'яті не більше %zu, дельт %zu\n",
+                static_cast<unsigned long long>(dungeon.get_chunks_generated()), max_loaded,
+                deltas_after_walk);
+    if (rss_start && rss_end) {
+        std::printf("RSS              %zu KiB -> %zu KiB\n", rss_start, rss_end);
+    }
+    std::printf("перегенерація: план %s, перемоги збережено %s, детермінованість %s\n",
+                layout_same ? "так" : "НІ", kills_kept ? "так" : "НІ", deterministic ? "так" : "НІ");
+    std::printf("обмеження дельт: %s\n", bounded ? "так" : "НІ");
+    return layout_same && kills_kept && deterministic && bounded ? 0 : 2;
+}
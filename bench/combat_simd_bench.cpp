@@ -0,0 +1,129 @@
+#include "Benchmarks.hpp"
+#include "CombatKernels.hpp"
+#include "CombatStore.hpp"
+#include "Goblin.hpp"
+#include "Orc.hpp"
+#include "Wraith.hpp"
+#include "Random.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// Пакетне ядро шкоди (apply_damage_batch) проти take_damage по одному об'єкту.
+// Спершу перевіряє, що результат ідентичний скалярному шляху Character::take_damage /
+// Wraith::take_damage для гоблінів, орків і примар — і на випадкових бійцях, і на
+// крайових (шкода не більша за захист, добивання з надлишком, нульова й від'ємна
+// атака). Ненульовий код виходу, якщо ні; так його запускає make check. Потім
+// міряє швидкість.
+//
+// Параметри: [кількість бійців (типово 1000000)] [раундів (типово 20)]
+
+int run_combat_simd_bench(int argc, char* argv[])
+{
+    const size_t count = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 1000000;
+    const int rounds = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    constexpr int enemy_kinds = 3;
+    const char* const kind_names[enemy_kinds] = { "гоблін", "орк", "примара" };
+    auto make_enemy_of_kind = [](int kind) -> std::unique_ptr<Enemy> {
+        if (kind == 0) return std::make_unique<Goblin>();
+        if (kind == 1) return std::make_unique<Orc>();
+        return std::make_unique<Wraith>();
+    };
+
+    // Крайові бійці кожного виду: (зміна захисту, HP); по них б'ють за колом
+    // edge_amounts — нижче захисту, рівно в захист, на 1 більше, з надлишком
+    struct EdgeFighter { int defense_delta; int hp; };
+    const EdgeFighter edge_fighters[] = { { 0, 1 }, { 0, 5 }, { 40, 50 }, { 200, 30 }, { -5, 2 } };
+    const int32_t edge_amounts[] = { 0, -7, 1, 2, 5, 10, 15, 16, 45, 46, 250, 100000 };
+    constexpr size_t num_edge_amounts = sizeof(edge_amounts) / sizeof(edge_amounts[0]);
+    const size_t edge_count = enemy_kinds * (sizeof(edge_fighters) / sizeof(edge_fighters[0]));
+
+    std::vector<std::unique_ptr<Enemy>> objects;
+    std::vector<int> kinds;
+    objects.reserve(edge_count + count);
+    kinds.reserve(edge_count + count);
+    CombatStore store;
+    store.reserve(edge_count + count);
+    auto add_fighter = [&](int kind, int defense_delta, int hp) {
+        std::unique_ptr<Enemy> enemy = make_enemy_of_kind(kind);
+        enemy->modify_defense(defense_delta);
+        enemy->set_hp(hp);
+        store.add(*enemy);
+        objects.push_back(std::move(enemy));
+        kinds.push_back(kind);
+    };
+    for (int kind = 0; kind < enemy_kinds; ++kind) {
+        for (const EdgeFighter& edge : edge_fighters) add_fighter(kind, edge.defense_delta, edge.hp);
+    }
+
+    // Випадкові бійці: гобліни, орки (без резисту) та примари (50%), різний захист і HP
+    int max_hp_of_kind[enemy_kinds];
+    for (int kind = 0; kind < enemy_kinds; ++kind) max_hp_of_kind[kind] = make_enemy_of_kind(kind)->get_max_hp();
+    Rng rng(42);
+    for (size_t i = 0; i < count; ++i) {
+        const int kind = static_cast<int>(rng.below(enemy_kinds));
+        const int max_hp = max_hp_of_kind[kind];
+        const int defense_delta = static_cast<int>(rng.below(40)) - 5;
+        add_fighter(kind, defense_delta, 1 + static_cast<int>(rng.below(static_cast<uint32_t>(max_hp))));
+    }
+    const size_t total = edge_count + count;
+
+    std::vector<std::vector<int32_t>> amounts(static_cast<size_t>(rounds), std::vector<int32_t>(total));
+    for (size_t r = 0; r < amounts.size(); ++r) {
+        auto& round = amounts[r];
+        for (size_t i = 0; i < edge_count; ++i) round[i] = edge_amounts[(i + r) % num_edge_amounts];
+        for (size_t i = edge_count; i < total; ++i) round[i] = static_cast<int32_t>(rng.below(120)) - 10;
+    }
+
+    // 1) Перевірка еквівалентності
+    auto t0 = Clock::now();
+    for (const auto& round : amounts) {
+        for (size_t i = 0; i < total; ++i) {
+            if (round[i] > 0) objects[i]->take_damage(round[i]);
+        }
+    }
+    const double object_ms = elapsed_ms(t0);
+
+    CombatStore scalar_store = store;
+    t0 = Clock::now();
+    for (const auto& round : amounts) {
+        apply_damage_batch_scalar(scalar_store.hp_data(), scalar_store.defense_data(),
+                                  scalar_store.resistance_data(), round.data(), total);
+    }
+    const double scalar_ms = elapsed_ms(t0);
+
+    t0 = Clock::now();
+    for (const auto& round : amounts) {
+        store.apply_damage_all(round.data());
+    }
+    const double batch_ms = elapsed_ms(t0);
+
+    size_t mismatches = 0;
+    size_t kind_mismatches[enemy_kinds] = {};
+    size_t kind_counts[enemy_kinds] = {};
+    for (size_t i = 0; i < total; ++i) {
+        ++kind_counts[kinds[i]];
+        if (objects[i]->get_hp() != store.get_hp(static_cast<CombatStore::index_type>(i)) ||
+            objects[i]->get_hp() != scalar_store.get_hp(static_cast<CombatStore::index_type>(i))) {
+            ++mismatches;
+            ++kind_mismatches[kinds[i]];
+        }
+    }
+
+    std::printf("бійців=%zu раундів=%d avx2=%s\n", total, rounds, combat_kernels_use_avx2() ? "так" : "ні");
+    std::printf("take_damage (об'єкти)   %9.2f ms  %6.2f ns/бійця\n", object_ms, object_ms * 1e6 / (total * rounds));
+    std::printf("apply_damage скалярне   %9.2f ms  %6.2f ns/бійця\n", scalar_ms, scalar_ms * 1e6 / (total * rounds));
+    std::printf("apply_damage_batch      %9.2f ms  %6.2f ns/бійця\n", batch_ms, batch_ms * 1e6 / (total * rounds));
+    for (int kind = 0; kind < enemy_kinds; ++kind) {
+        std::printf("%s: бійців %zu, розбіжностей %zu\n", kind_names[kind], kind_counts[kind], kind_mismatches[kind]);
+    }
+    std::printf("розбіжностей: %zu (крайових бійців %zu)\n", mismatches, edge_count);
+    if (mismatches > 0) {
+        std::fprintf(stderr, "combat-simd: пакетне ядро не збігається з take_damage (%zu бійців)\n", mismatches);
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include "Benchmarks.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+struct BenchEntry {
+    const char* name;
+    const char* description;
+    int (*run)(int argc, char* argv[]);
+};
+
+// Інструментовані бенчмарки (облік виділень, трасування) живуть в окремому
+// двійковому файлі, щоб не спотворювати виміри часу решти (див. bench.pro)
+const BenchEntry benches[] = {
+#ifdef DUNGEON_INSTRUMENTED_BENCH
+    { "micro", "мікробенчмарки: нс/оп, виділень/оп, пікове RSS (--json)", run_micro_bench },
+    { "alloc-turn", "виділення купи за хід гри (AllocTracker): підсумки й зведення", run_alloc_turn_bench },
+    { "trace", "маркери трасування: ціна маркера і траса сесії у Chrome JSON", run_trace_bench },
+#else
+    { "pathfinding", "bfs (звичайний і двонаправлений) vs dijkstra vs a_star", run_pathfinding_bench },
+    { "parallel-bfs", "масштабування parallel_bfs за потоками", run_parallel_bfs_bench },
+    { "combat-simd", "пакетне ядро шкоди (AVX2) проти take_damage + перевірка", run_combat_simd_bench },
+    { "map-arena", "генерація/знищення карти: купа проти арени", run_map_arena_bench },
+    { "map-memory", "пам'ять на кімнату для карти з 10^6 кімнат", run_map_memory_bench },
+    { "chunked", "потокове чанкове підземелля: старт, прохід, вивантаження", run_chunked_bench },
+    { "parallel-gen", "паралельна детермінована генерація карти: масштабування", run_parallel_gen_bench },
+    { "snapshot", "бінарний знімок гри: збереження, mmap-завантаження, відтворення", run_snapshot_bench },
+#endif
+};
+
+void print_usage(const char* program) {
+    std::printf("Використання: %s <бенчмарк> [параметри]\n\n", program);
+    for (const auto& bench : benches) {
+        std::printf("  %-14s %s\n", bench.name, bench.description);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    for (const auto& bench : benches) {
+        if (std::strcmp(argv[1], bench.name) == 0) {
+            return bench.run(argc - 1, argv + 1);
+        }
+    }
+
+    std::fprintf(stderr, "Невідомий бенчмарк: %s\n\n", argv[1]);
+    print_usage(argv[0]);
+    return 1;
+}
@@ -0,0 +1,72 @@
+#include "Benchmarks.hpp"
+#include "GameMap.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include <vector>
+
+// Цикли "згенерувати карту -> знищити" у купі (як раніше) і в арені
+// (monotonic_buffer_resource, скидається release() між іграми).
+// Обидва шляхи з тим самим зерном мають дати однакові карти — це теж перевіряється.
+// Арена не окупається (граф і назви лишаються в купі), тому GameEngine її не вмикає;
+// GameMap(arena) лишається для тих, кому це вигідно.
+//
+// Параметри: [кімнат (типово 12)] [циклів (типово 20000)]
+
+namespace {
+
+// Дешевий відбиток карти для порівняння двох шляхів
+size_t map_fingerprint(GameMap& map) {
+    size_t hash = 0;
+    for (size_t i = 0; i < map.get_num_rooms(); ++i) {
+        MapNode* node = map.get_node_by_id(static_cast<int>(i));
+        hash = hash * 31 + std::hash<std::string_view>()(node->get_description());
+        hash = hash * 31 + (node->has_enemy() ? std::hash<std::string>()(map.get_enemy(*node)->get_name()) : 1);
+        hash = hash * 31 + (node->has_item() ? std::hash<std::string_view>()(map.get_item(*node)->get_name()) : 2);
+        hash = hash * 31 + map.get_num_neighbors(static_cast<int>(i));
+    }
+    return hash;
+}
+
+} // namespace
+
+int run_map_arena_bench(int argc, char* argv[])
+{
+    const int num_rooms = argc > 1 ? std::atoi(argv[1]) : 12;
+    const int cycles = argc > 2 ? std::atoi(argv[2]) : 20000;
+    const int num_enemies = num_rooms / 2;
+    const int num_items = num_rooms / 2 + 1;
+
+    size_t heap_hash = 0;
+    Rng rng(2024);
+    auto t0 = Clock::now();
+    for (int i = 0; i < cycles; ++i) {
+        auto map = std::make_unique<GameMap>();
+        map->generate_map(num_rooms, num_enemies, num_items, rng);
+        if (i == cycles - 1) heap_hash = map_fingerprint(*map);
+    }
+    const double heap_ms = elapsed_ms(t0);
+
+    std::vector<std::byte> buffer(static_cast<size_t>(num_rooms) * 512 + 4096);
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+    size_t arena_hash = 0;
+    rng.reseed(2024);
+    t0 = Clock::now();
+    for (int i = 0; i < cycles; ++i) {
+        auto map = std::make_unique<GameMap>(&arena);
+        map->generate_map(num_rooms, num_enemies, num_items, rng);
+        if (i == cycles - 1) arena_hash = map_fingerprint(*map);
+        map.reset();
+        arena.release();
+    }
+    const double arena_ms = elapsed_ms(t0);
+
+    std::printf("кімнат=%d циклів=%d\n", num_rooms, cycles);
+    std::printf("купа   %9.2f ms  %8.2f us/карту\n", heap_ms, heap_ms * 1000.0 / cycles);
+    std::printf("арена  %9.2f ms  %8.2f us/карту  (x%.2f)\n", arena_ms, arena_ms * 1000.0 / cycles,
+                arena_ms > 0 ? heap_ms / arena_ms : 0.0);
+    std::printf("карти однакові: %s\n", heap_hash == arena_hash ? "так" : "НІ");
+    return heap_hash == arena_hash ? 0 : 2;
+}
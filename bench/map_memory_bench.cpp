@@ -0,0 +1,53 @@
+#include "Benchmarks.hpp"
+#include "GameMap.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+// Пам'ять на кімнату для великих карт: розклад за структурами (кімнати, CSR-граф)
+// і реальний приріст RSS процесу разом з ворогами й предметами (лише Linux).
+//
+// Параметри: [кімнат (типово 1000000)]
+
+namespace {
+
+// Resident set size процесу в байтах (0, якщо недоступно)
+size_t resident_bytes() {
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    if (!(statm >> total_pages >> resident_pages)) return 0;
+    return resident_pages * 4096;
+}
+
+} // namespace
+
+int run_map_memory_bench(int argc, char* argv[])
+{
+    const int num_rooms = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    if (num_rooms < 1) return 1;
+
+    const size_t rss_before = resident_bytes();
+    GameMap map;
+    Rng rng(7);
+    map.generate_map(num_rooms, num_rooms / 2, num_rooms / 2 + 1, rng);
+    const size_t rss_after = resident_bytes();
+
+    const double rooms = static_cast<double>(num_rooms);
+    const size_t node_bytes = map.get_num_rooms() * sizeof(MapNode);
+    const size_t graph_bytes = map.get_graph().memory_bytes();
+
+    std::printf("кімнат=%d ребер=%zu sizeof(MapNode)=%zu\n",
+                num_rooms, map.get_graph().num_edges(), sizeof(MapNode));
+    std::printf("кімнати        %8.1f байт/кімнату\n", node_bytes / rooms);
+    std::printf("граф (CSR)     %8.1f байт/кімнату\n", graph_bytes / rooms);
+    std::printf("разом          %8.1f байт/кімнату  (%.1f MiB)\n",
+                map.memory_bytes() / rooms, map.memory_bytes() / (1024.0 * 1024.0));
+    if (rss_before && rss_after >= rss_before) {
+        std::printf("приріст RSS    %8.1f байт/кімнату  (з ворогами, предметами й пам'яттю, яку\n"
+                    "               аллокатор утримав після тимчасового хеш-графа генерації)\n",
+                    (rss_after - rss_before) / rooms);
+    }
+    return 0;
+}
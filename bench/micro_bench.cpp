@@ -0,0 +1,289 @@
+#include "AllocTracker.hpp"
+#include "Benchmarks.hpp"
+#include "GameEngine.hpp"
+#include "GameMap.hpp"
+#include "Graph.hpp"
+#include "TraversalContext.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Мікробенчмарки гарячих шляхів для відстеження регресій: побудова Graph
+// (add_node / add_edge), bfs / dfs, GameMap::get_neighbors, generate_map на
+// 10^2..10^6 кімнат, allEnemiesDefeated і повний автоматичний цикл бою GameEngine.
+// Для кожного — нс/операцію, виділень купи та байт на операцію і пікове RSS процесу
+// після вимірювання; увесь облік пам'яті — з AllocTracker (збірка bench.pro з
+// CONFIG+=instrumented), власних лічильників у наборі немає.
+//
+// Параметри: [--json] [--max-rooms N (типово 1000000)] [--min-ms M (типово 200)]
+// --json — один JSON-об'єкт у stdout замість таблиці.
+
+#ifndef DUNGEON_ALLOC_TRACKING
+#error "micro_bench рахує виділення через AllocTracker: потрібен DUNGEON_ALLOC_TRACKING (qmake CONFIG+=instrumented)"
+#endif
+
+namespace {
+
+using alloc_tracking::Counts;
+using alloc_tracking::peak_rss_bytes;
+
+// Вимірюваний відрізок усередині повторення: час і виділення між begin() та end()
+class Sample {
+private:
+    Clock::time_point started_;
+    Counts allocs_at_start_;
+
+public:
+    double ns = 0;
+    uint64_t allocs = 0;
+    uint64_t bytes = 0;
+
+    void begin() {
+        allocs_at_start_ = alloc_tracking::totals();
+        started_ = Clock::now();
+    }
+
+    void end() {
+        const auto stopped = Clock::now();
+        const Counts now = alloc_tracking::totals();
+        ns += std::chrono::duration<double, std::nano>(stopped - started_).count();
+        allocs += now.count - allocs_at_start_.count;
+        bytes += now.bytes - allocs_at_start_.bytes;
+    }
+};
+
+struct Result {
+    std::string name;
+    size_t size = 0;        // Кімнат / вузлів (0 — не залежить від розміру)
+    uint64_t ops = 0;       // Усього виміряних операцій
+    double ns_per_op = 0;
+    double allocs_per_op = 0;
+    double bytes_per_op = 0;
+    size_t peak_rss = 0;    // Байт, після цього бенчмарку
+};
+
+// Не дає компілятору викинути результат
+volatile uint64_t sink = 0;
+
+// Повторює fn(sample), поки виміряний час не перевищить min_ms (але хоча б раз).
+// fn повертає кількість операцій за повторення.
+template <typename Fn>
+Result measure(const char* name, size_t size, double min_ms, Fn&& fn) {
+    Sample sample;
+    uint64_t ops = 0;
+    do {
+        ops += fn(sample);
+    } while (sample.ns < min_ms * 1e6);
+
+    Result result;
+    result.name = name;
+    result.size = size;
+    result.ops = ops;
+    result.ns_per_op = ops ? sample.ns / static_cast<double>(ops) : 0;
+    result.allocs_per_op = ops ? static_cast<double>(sample.allocs) / static_cast<double>(ops) : 0;
+    result.bytes_per_op = ops ? static_cast<double>(sample.bytes) / static_cast<double>(ops) : 0;
+    result.peak_rss = peak_rss_bytes();
+    return result;
+}
+
+// Ребра, як у generate_map: лінійний шлях і n / 2 випадкових
+std::vector<std::pair<uint32_t, uint32_t>> map_like_edges(size_t n, uint64_t seed) {
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    for (size_t i = 0; i + 1 < n; ++i) edges.emplace_back(static_cast<uint32_t>(i), static_cast<uint32_t>(i + 1));
+    Rng rng(seed);
+    for (size_t i = 0; i < n / 2; ++i) {
+        edges.emplace_back(rng.below(static_cast<uint32_t>(n)), rng.below(static_cast<uint32_t>(n)));
+    }
+    return edges;
+}
+
+void bench_graph(size_t n, double min_ms, std::vector<Result>& results) {
+    const auto edges = map_like_edges(n, n);
+
+    results.push_back(measure("graph.add_node", n, min_ms, [n](Sample& sample) -> uint64_t {
+        Graph<uint32_t> graph;
+        sample.begin();
+        for (size_t i = 0; i < n; ++i) graph.add_node(static_cast<uint32_t>(i));
+        sample.end();
+        return n;
+    }));
+
+    results.push_back(measure("graph.add_edge", n, min_ms, [n, &edges](Sample& sample) -> uint64_t {
+        Graph<uint32_t> graph;
+        for (size_t i = 0; i < n; ++i) graph.add_node(static_cast<uint32_t>(i));
+        sample.begin();
+        for (const auto& edge : edges) graph.add_undirected_edge(edge.first, edge.second);
+        sample.end();
+        return edges.size();
+    }));
+}
+
+void bench_map(size_t n, double min_ms, std::vector<Result>& results) {
+    const int rooms = static_cast<int>(n);
+
+    results.push_back(measure("map.generate_map", n, min_ms, [rooms](Sample& sample) -> uint64_t {
+        GameMap map;
+        Rng rng(static_cast<uint64_t>(rooms));
+        sample.begin();
+        map.generate_map(rooms, rooms / 2, rooms / 2 + 1, rng);
+        sample.end();
+        return 1;
+    }));
+
+    GameMap map;
+    Rng rng(99);
+    map.generate_map(rooms, rooms / 2, rooms / 2 + 1, rng);
+    const Graph<uint32_t>& graph = map.get_graph();
+    const uint32_t last = static_cast<uint32_t>(n - 1);
+
+    // Шлях від першої кімнати до останньої (весь граф у гіршому разі)
+    results.push_back(measure("graph.bfs", n, min_ms, [&graph, last](Sample& sample) -> uint64_t {
+        sample.begin();
+        sink = sink + graph.bfs(0, last).size();
+        sample.end();
+        return 1;
+    }));
+
+    TraversalContext context(graph.size());
+    std::vector<uint32_t> path;
+    results.push_back(measure("graph.bfs_context", n, min_ms, [&](Sample& sample) -> uint64_t {
+        sample.begin();
+        graph.bfs(0, last, context, path);
+        sample.end();
+        sink = sink + path.size();
+        return 1;
+    }));
+
+    results.push_back(measure("graph.dfs", n, min_ms, [&graph, last](Sample& sample) -> uint64_t {
+        sample.begin();
+        sink = sink + graph.dfs(0, last).size();
+        sample.end();
+        return 1;
+    }));
+
+    // get_neighbors для 1024 випадкових кімнат за повторення
+    std::vector<int> ids(1024);
+    for (int& id : ids) id = static_cast<int>(rng.below(static_cast<uint32_t>(n)));
+    results.push_back(measure("map.get_neighbors", n, min_ms, [&map, &ids](Sample& sample) -> uint64_t {
+        sample.begin();
+        for (int id : ids) sink = sink + map.get_neighbors(id).size();
+        sample.end();
+        return ids.size();
+    }));
+
+    results.push_back(measure("map.all_enemies_defeated", n, min_ms, [&map](Sample& sample) -> uint64_t {
+        constexpr uint64_t calls = 1 << 20;
+        GameMap* volatile target = &map; // Кожен виклик справжній, без винесення з циклу
+        uint64_t defeated = 0;
+        sample.begin();
+        for (uint64_t i = 0; i < calls; ++i) defeated += target->allEnemiesDefeated() ? 1 : 0;
+        sample.end();
+        sink = sink + defeated;
+        return calls;
+    }));
+}
+
+// Повні ігри ботом (б'є ворогів, підбирає предмети, ходить випадково);
+// операція — одна дія гравця
+void bench_combat_loop(double min_ms, std::vector<Result>& results) {
+    uint64_t game = 0;
+    results.push_back(measure("engine.combat_loop", 0, min_ms, [&game](Sample& sample) -> uint64_t {
+        GameEngine engine;
+        Rng driver(game);
+        uint64_t actions = 0;
+        sample.begin();
+        engine.start("Бот", static_cast<PlayerClass>(game % 3), game);
+        while (engine.is_running() && actions < 10000) {
+            if (engine.get_current_enemy()) {
+                engine.attack();
+            } else if (engine.get_current_item()) {
+                engine.take_item();
+            } else {
+                const size_t exits = engine.get_map()->get_num_neighbors(engine.get_current_room_id());
+                engine.move(static_cast<int>(driver.below(static_cast<uint32_t>(exits))));
+            }
+            ++actions;
+        }
+        sample.end();
+        ++game;
+        return actions;
+    }));
+}
+
+// printf рахує ширину в байтах, а заголовки — кирилиця (2 байти на літеру)
+void print_column(const char* text, int width, bool left = false) {
+    int letters = 0;
+    for (const char* c = text; *c; ++c) {
+        if ((static_cast<unsigned char>(*c) & 0xC0) != 0x80) ++letters;
+    }
+    const int pad = width > letters ? width - letters : 0;
+    if (left) std::printf("%s%*s", text, pad, "");
+    else std::printf("%*s%s", pad, "", text);
+}
+
+void print_table(const std::vector<Result>& results) {
+    print_column("бенчмарк", 26, true);
+    const char* const columns[] = { "розмір", "операцій", "нс/оп", "виділень/оп", "байт/оп", "RSS MiB" };
+    const int widths[] = { 9, 12, 14, 12, 12, 10 };
+    for (size_t i = 0; i < 6; ++i) {
+        std::printf(" ");
+        print_column(columns[i], widths[i]);
+    }
+    std::printf("\n");
+    for (const auto& r : results) {
+        std::printf("%-26s %9zu %12llu %14.1f %12.2f %12.1f %10.1f\n",
+                    r.name.c_str(), r.size, static_cast<unsigned long long>(r.ops),
+                    r.ns_per_op, r.allocs_per_op, r.bytes_per_op, r.peak_rss / (1024.0 * 1024.0));
+    }
+    std::printf("пікове RSS: %.1f MiB\n", peak_rss_bytes() / (1024.0 * 1024.0));
+}
+
+void print_json(const std::vector<Result>& results) {
+    std::printf("{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        std::printf("    {\"name\": \"%s\", \"size\": %zu, \"ops\": %llu, \"ns_per_op\": %.3f, "
+                    "\"allocs_per_op\": %.4f, \"bytes_per_op\": %.2f, \"peak_rss_bytes\": %zu}%s\n",
+                    r.name.c_str(), r.size, static_cast<unsigned long long>(r.ops),
+                    r.ns_per_op, r.allocs_per_op, r.bytes_per_op, r.peak_rss,
+                    i + 1 < results.size() ? "," : "");
+    }
+    std::printf("  ],\n  \"peak_rss_bytes\": %zu\n}\n", peak_rss_bytes());
+}
+
+} // namespace
+
+int run_micro_bench(int argc, char* argv[])
+{
+    bool json = false;
+    size_t max_rooms = 1000000;
+    double min_ms = 200;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (std::strcmp(argv[i], "--max-rooms") == 0 && i + 1 < argc) {
+            max_rooms = static_cast<size_t>(std::atol(argv[++i]));
+        } else if (std::strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+            min_ms = std::atof(argv[++i]);
+        } else {
+            std::fprintf(stderr, "Невідомий параметр: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    std::vector<Result> results;
+    for (size_t n = 100; n <= max_rooms; n *= 10) {
+        bench_graph(n, min_ms, results);
+        bench_map(n, min_ms, results);
+    }
+    bench_combat_loop(min_ms, results);
+
+    if (json) print_json(results);
+    else print_table(results);
+    return 0;
+}
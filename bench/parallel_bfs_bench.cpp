@@ -0,0 +1,63 @@
+#include "Benchmarks.hpp"
+#include "GameMap.hpp"
+#include "ParallelBfs.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Масштабування parallel_bfs за кількістю потоків (1, 2, 4, ... до N) на
+// згенерованій карті, з перевіркою, що шлях збігається з послідовним bfs.
+//
+// Параметри: [кількість кімнат (типово 1000000)] [макс. потоків (типово всі ядра)]
+
+int run_parallel_bfs_bench(int argc, char* argv[])
+{
+    const int num_rooms = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const unsigned max_threads = resolve_thread_count(argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 0);
+    const int num_queries = 5;
+    if (num_rooms < 2) return 1;
+
+    GameMap map;
+    map.generate_map(num_rooms, 0, 0);
+    const Graph<uint32_t>& graph = map.get_graph();
+
+    std::mt19937 rng(2024);
+    std::uniform_int_distribution<int> pick(0, num_rooms - 1);
+    std::vector<std::pair<uint32_t, uint32_t>> queries;
+    queries.emplace_back(0u, static_cast<uint32_t>(num_rooms - 1));
+    while (static_cast<int>(queries.size()) < num_queries) {
+        queries.emplace_back(static_cast<uint32_t>(pick(rng)), static_cast<uint32_t>(pick(rng)));
+    }
+
+    // Обидва боки на "теплих" робочих просторах: вимірюється сам пошук, а не виділення
+    TraversalContext serial_context(graph.size());
+    std::vector<std::vector<uint32_t>> expected(queries.size());
+    auto t0 = Clock::now();
+    for (size_t i = 0; i < queries.size(); ++i) {
+        graph.bfs(queries[i].first, queries[i].second, serial_context, expected[i]);
+    }
+    const double serial_ms = elapsed_ms(t0) / num_queries;
+    std::printf("rooms=%d edges=%zu queries=%d\n", num_rooms, graph.num_edges(), num_queries);
+    std::printf("serial bfs          %9.2f ms/q\n", serial_ms);
+
+    for (unsigned threads = 1;; threads = std::min(threads * 2, max_threads)) {
+        ParallelBfsStats stats;
+        ParallelBfsContext context;
+        parallel_bfs(graph, context, queries[0].first, queries[0].second, threads); // прогрів контексту й пулу
+        bool identical = true;
+        t0 = Clock::now();
+        for (size_t i = 0; i < queries.size(); ++i) {
+            identical &= parallel_bfs(graph, context, queries[i].first, queries[i].second, threads, &stats) == expected[i];
+        }
+        const double parallel_ms = elapsed_ms(t0) / num_queries;
+        std::printf("parallel bfs t=%-3u %9.2f ms/q  x%.2f  (рівнів top-down %u, bottom-up %u)%s\n",
+                    threads, parallel_ms, serial_ms / parallel_ms,
+                    stats.top_down_levels, stats.bottom_up_levels,
+                    identical ? "" : "  [ШЛЯХ ВІДРІЗНЯЄТЬСЯ!]");
+        if (threads == max_threads) break;
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "Benchmarks.hpp"
+#include "GameMap.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <string_view>
+
+// Паралельна детермінована генерація (generate_map_parallel): масштабування за
+// кількістю потоків і перевірка, що карта біт-у-біт однакова для будь-якої з них.
+// Для порівняння — послідовна generate_map того ж розміру.
+//
+// Параметри: [кімнат (типово 1000000)] [макс. потоків (типово всі ядра)]
+
+namespace {
+
+size_t map_fingerprint(GameMap& map) {
+    size_t hash = map.get_graph().num_edges();
+    for (size_t i = 0; i < map.get_num_rooms(); ++i) {
+        const int id = static_cast<int>(i);
+        MapNode* node = map.get_node_by_id(id);
+        hash = hash * 31 + node->get_type() * 16 + node->get_feature();
+        hash = hash * 31 + (node->has_enemy() ? std::hash<std::string>()(map.get_enemy(*node)->get_name()) : 1);
+        hash = hash * 31 + (node->has_item() ? std::hash<std::string_view>()(map.get_item(*node)->get_name()) : 2);
+        map.for_each_neighbor(id, [&hash](MapNode* neighbor) { hash = hash * 31 + neighbor->get_id(); });
+    }
+    return hash;
+}
+
+} // namespace
+
+int run_parallel_gen_bench(int argc, char* argv[])
+{
+    const int num_rooms = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const unsigned max_threads = resolve_thread_count(argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 0);
+    const int num_enemies = num_rooms / 2;
+    const int num_items = num_rooms / 2 + 1;
+    const uint64_t seed = 31337;
+
+    auto t0 = Clock::now();
+    {
+        GameMap map;
+        Rng rng(seed);
+        map.generate_map(num_rooms, num_enemies, num_items, rng);
+    }
+    const double serial_ms = elapsed_ms(t0);
+    std::printf("кімнат=%d\n", num_rooms);
+    std::printf("generate_map (послідовно)   %9.2f ms\n", serial_ms);
+
+    size_t reference = 0;
+    bool identical = true;
+    for (unsigned threads = 1;; threads = std::min(threads * 2, max_threads)) {
+        GameMap map;
+        t0 = Clock::now();
+        map.generate_map_parallel(num_rooms, num_enemies, num_items, seed, threads);
+        const double parallel_ms = elapsed_ms(t0);
+
+        const size_t fingerprint = map_fingerprint(map);
+        if (threads == 1) reference = fingerprint;
+        const bool same = fingerprint == reference;
+        identical &= same;
+        std::printf("generate_map_parallel t=%-3u %9.2f ms  x%.2f%s\n", threads, parallel_ms,
+                    parallel_ms > 0 ? serial_ms / parallel_ms : 0.0, same ? "" : "  [КАРТА ВІДРІЗНЯЄТЬСЯ!]");
+        if (threads == max_threads) break;
+    }
+    return identical ? 0 : 2;
+}
@@ -0,0 +1,193 @@
+#include "Benchmarks.hpp"
+#include "GameMap.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Порівняння bfs / dijkstra / a_star.
+// 1) Карти GameMap::generate_map (одиничні ваги): bfs (звичайний і двонаправлений)
+//    проти dijkstra на тих самих запитах, з кількістю розкритих вузлів.
+// 2) Зважена решітка, де манхеттенська відстань — допустима евристика для a_star.
+//    Частина запитів повторюється на тій самій решітці до compact() (хеш-представлення):
+//    вартості мають збігтися, інакше ненульовий код виходу.
+//
+// Параметри: [кількість кімнат...] (типово 10000 100000 1000000)
+
+namespace {
+
+double elapsed_us(Clock::time_point since) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - since).count();
+}
+
+void bench_generated_map(int num_rooms, int num_queries) {
+    GameMap map;
+    auto t0 = Clock::now();
+    map.generate_map(num_rooms, 0, 0);
+    double generate_us = elapsed_us(t0);
+
+    const Graph<uint32_t>& graph = map.get_graph();
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> pick(0, num_rooms - 1);
+
+    std::vector<std::pair<uint32_t, uint32_t>> queries;
+    for (int i = 0; i < num_queries; ++i) {
+        queries.emplace_back(static_cast<uint32_t>(pick(rng)), static_cast<uint32_t>(pick(rng)));
+    }
+
+    size_t total_hops = 0;
+    t0 = Clock::now();
+    for (const auto& q : queries) {
+        total_hops += graph.bfs(q.first, q.second).size();
+    }
+    double bfs_us = elapsed_us(t0);
+
+    TraversalContext context(graph.size());
+    std::vector<uint32_t> path;
+    size_t bfs_ctx_hops = 0;
+    size_t bfs_explored = 0;
+    t0 = Clock::now();
+    for (const auto& q : queries) {
+        graph.bfs(q.first, q.second, context, path);
+        bfs_ctx_hops += path.size();
+        bfs_explored += context.explored();
+    }
+    double bfs_ctx_us = elapsed_us(t0);
+
+    size_t bidir_hops = 0;
+    size_t bidir_explored = 0;
+    t0 = Clock::now();
+    for (const auto& q : queries) {
+        graph.bfs(q.first, q.second, context, path, BfsMode::Bidirectional);
+        bidir_hops += path.size();
+        bidir_explored += context.explored();
+    }
+    double bidir_us = elapsed_us(t0);
+
+    size_t dijkstra_hops = 0;
+    t0 = Clock::now();
+    for (const auto& q : queries) {
+        graph.dijkstra(q.first, q.second, context, path);
+        dijkstra_hops += path.size();
+    }
+    double dijkstra_us = elapsed_us(t0);
+
+    std::printf("rooms=%-8d gen=%9.1f ms | bfs %9.1f us/q | bfs+ctx %9.1f us/q | bidir+ctx %9.1f us/q"
+                " | dijkstra+ctx %9.1f us/q%s\n",
+                num_rooms, generate_us / 1000.0,
+                bfs_us / num_queries, bfs_ctx_us / num_queries, bidir_us / num_queries, dijkstra_us / num_queries,
+                (total_hops == bfs_ctx_hops && total_hops == bidir_hops && total_hops == dijkstra_hops)
+                    ? "" : "  [РІЗНІ ДОВЖИНИ!]");
+    std::printf("%-19s explored/q: bfs %.0f, bidir %.0f (%.1fx менше)\n", "",
+                static_cast<double>(bfs_explored) / num_queries,
+                static_cast<double>(bidir_explored) / num_queries,
+                bidir_explored ? static_cast<double>(bfs_explored) / bidir_explored : 0.0);
+}
+
+// false, якщо вартості шляхів розійшлися
+bool bench_weighted_grid(int side, int num_queries) {
+    Graph<int> grid;
+    for (int i = 0; i < side * side; ++i) grid.add_node(i);
+
+    std::mt19937 rng(777);
+    std::uniform_int_distribution<int> cost(1, 5);
+    for (int y = 0; y < side; ++y) {
+        for (int x = 0; x < side; ++x) {
+            int id = y * side + x;
+            if (x + 1 < side) grid.add_undirected_edge(id, id + 1, cost(rng));
+            if (y + 1 < side) grid.add_undirected_edge(id, id + side, cost(rng));
+        }
+    }
+    const Graph<int> hash_grid = grid;
+    grid.compact();
+
+    std::uniform_int_distribution<int> pick(0, side * side - 1);
+    std::vector<std::pair<int, int>> queries;
+    for (int i = 0; i < num_queries; ++i) queries.emplace_back(pick(rng), pick(rng));
+
+    TraversalContext context(grid.size());
+    std::vector<int> path;
+
+    double dijkstra_total = 0;
+    auto t0 = Clock::now();
+    for (const auto& q : queries) {
+        double cost_found = 0;
+        grid.dijkstra(q.first, q.second, context, path, &cost_found);
+        dijkstra_total += cost_found;
+    }
+    double dijkstra_us = elapsed_us(t0);
+
+    double a_star_total = 0;
+    t0 = Clock::now();
+    for (const auto& q : queries) {
+        const int goal = q.second;
+        auto manhattan = [side, goal](int node) {
+            return static_cast<double>(std::abs(node % side - goal % side) + std::abs(node / side - goal / side));
+        };
+        double cost_found = 0;
+        grid.a_star(q.first, q.second, manhattan, context, path, &cost_found);
+        a_star_total += cost_found;
+    }
+    double a_star_us = elapsed_us(t0);
+
+    t0 = Clock::now();
+    for (const auto& q : queries) {
+        grid.bfs(q.first, q.second, context, path);
+    }
+    double bfs_us = elapsed_us(t0);
+
+    // Ті самі запити до compact(): dijkstra і a_star по хеш-таблицях (повільно — лише частина)
+    const int hash_queries = std::min(num_queries, 10);
+    double compact_subset_total = 0;
+    double hash_dijkstra_total = 0;
+    double hash_a_star_total = 0;
+    t0 = Clock::now();
+    for (int i = 0; i < hash_queries; ++i) {
+        const auto& q = queries[static_cast<size_t>(i)];
+        const int goal = q.second;
+        auto manhattan = [side, goal](int node) {
+            return static_cast<double>(std::abs(node % side - goal % side) + std::abs(node / side - goal / side));
+        };
+        double cost_found = 0;
+        grid.dijkstra(q.first, q.second, context, path, &cost_found);
+        compact_subset_total += cost_found;
+        hash_grid.dijkstra(q.first, q.second, context, path, &cost_found);
+        hash_dijkstra_total += cost_found;
+        hash_grid.a_star(q.first, q.second, manhattan, context, path, &cost_found);
+        hash_a_star_total += cost_found;
+    }
+    double hash_us = elapsed_us(t0);
+
+    const bool same = std::abs(dijkstra_total - a_star_total) < 1e-6 &&
+        std::abs(compact_subset_total - hash_dijkstra_total) < 1e-6 &&
+        std::abs(compact_subset_total - hash_a_star_total) < 1e-6;
+    std::printf("grid=%dx%-5d          | bfs+ctx %9.1f us/q | dijkstra+ctx %9.1f us/q | a_star+ctx %9.1f us/q%s\n",
+                side, side, bfs_us / num_queries, dijkstra_us / num_queries, a_star_us / num_queries,
+                same ? "" : "  [РІЗНІ ВАРТОСТІ!]");
+    std::printf("%-19s без compact(): dijkstra + a_star по хеш-таблицях %9.1f us/q (%d запитів)\n", "",
+                hash_us / hash_queries, hash_queries);
+    return same;
+}
+
+} // namespace
+
+int run_pathfinding_bench(int argc, char* argv[])
+{
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; ++i) sizes.push_back(std::atoi(argv[i]));
+    if (sizes.empty()) sizes = { 10000, 100000, 1000000 };
+
+    for (int rooms : sizes) {
+        if (rooms < 2) continue;
+        bench_generated_map(rooms, rooms >= 1000000 ? 20 : 200);
+    }
+    if (!bench_weighted_grid(500, 100)) {
+        std::fprintf(stderr, "pathfinding: dijkstra / a_star дали різні вартості\n");
+        return 2;
+    }
+    return 0;
+}
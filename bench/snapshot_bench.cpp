@@ -0,0 +1,205 @@
+#include "Benchmarks.hpp"
+#include "Snapshot.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+
+// Бінарний знімок (Snapshot.hpp): збереження великої карти й завантаження з файлу,
+// відображеного через mmap і прочитаного в буфер, з перевіркою, що карта відновлена
+// біт-у-біт. Обидва шляхи однаково перевіряють записи й будують карту, тож різниця
+// між ними — лише ціна читання файлу.
+// Потім — знімок посеред гри: оригінал і відновлена гра отримують ті самі дії
+// й мають пройти їх однаково (включно з кидками Rng). Насамкінець пошкоджені
+// знімки мають відкидатися, не зачіпаючи поточну гру.
+//
+// Параметри: [кімнат (типово 1000000)] [файл (типово dungeon_bench.snap)]
+
+namespace {
+
+size_t map_fingerprint(GameMap& map) {
+    size_t hash = map.get_graph().num_edges();
+    for (size_t i = 0; i < map.get_num_rooms(); ++i) {
+        const int id = static_cast<int>(i);
+        MapNode* node = map.get_node_by_id(id);
+        hash = hash * 31 + node->get_type() * 16 + node->get_feature();
+        if (Enemy* enemy = map.get_enemy(*node)) {
+            hash = hash * 31 + static_cast<size_t>(enemy->get_combat_kind()) * 1000 + enemy->get_hp();
+        }
+        if (Item* item = map.get_item(*node)) {
+            hash = hash * 31 + std::hash<std::string_view>()(item->get_name()) + item->get_value();
+        }
+        map.for_each_neighbor(id, [&hash](MapNode* neighbor) { hash = hash * 31 + neighbor->get_id(); });
+    }
+    return hash;
+}
+
+size_t engine_fingerprint(const GameEngine& engine) {
+    size_t hash = static_cast<size_t>(engine.get_current_room_id());
+    hash = hash * 31 + static_cast<size_t>(engine.get_player_hp());
+    hash = hash * 31 + static_cast<size_t>(engine.get_enemy_hp());
+    hash = hash * 31 + (engine.is_running() ? 1 : 0);
+    if (Player* player = engine.get_player()) {
+        hash = hash * 31 + static_cast<size_t>(player->get_attack_power());
+        hash = hash * 31 + static_cast<size_t>(player->get_defense());
+        hash = hash * 31 + player->inventory_size();
+    }
+    if (GameMap* map = engine.get_map()) {
+        hash = hash * 31 + map->get_live_enemy_count();
+    }
+    return hash;
+}
+
+// Одна випадкова дія гравця (як у симуляторі: бій, предмет або перехід)
+void random_action(GameEngine& engine, Rng& driver) {
+    if (engine.get_current_enemy()) {
+        engine.attack();
+    } else if (engine.get_current_item()) {
+        engine.take_item();
+    } else if (engine.get_current_room_id() == engine.get_final_room_id() && driver.below(4) == 0) {
+        engine.exit_dungeon();
+    } else {
+        const size_t exits = engine.get_map()->get_num_neighbors(engine.get_current_room_id());
+        engine.move(exits ? static_cast<int>(driver.below(static_cast<uint32_t>(exits))) : 0);
+    }
+}
+
+// Перезаписує байти файлу (пошкодження знімка для перевірки)
+void patch_file(const std::string& path, size_t offset, const void* bytes, size_t size) {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+}
+
+// Пошкоджений знімок має бути відкинутий, а поточна гра — лишитися як була
+bool rejects_corruption(const std::string& path, size_t offset, const void* bytes, size_t size) {
+    GameEngine engine;
+    engine.start("Тест", PlayerClass::Archer, 77);
+    save_snapshot(engine, path);
+    patch_file(path, offset, bytes, size);
+
+    const size_t before = engine_fingerprint(engine);
+    try {
+        load_snapshot(engine, path);
+        return false;
+    } catch (const std::exception&) {
+    }
+    return engine.is_running() && engine.get_map() && engine.get_player() && engine_fingerprint(engine) == before;
+}
+
+} // namespace
+
+int run_snapshot_bench(int argc, char* argv[])
+{
+    const int num_rooms = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const std::string path = argc > 2 ? argv[2] : "dungeon_bench.snap";
+    if (num_rooms < 1) return 1;
+
+    try {
+        GameMap original;
+        original.generate_map_parallel(num_rooms, num_rooms / 2, num_rooms / 2 + 1, 4242);
+        const size_t reference = map_fingerprint(original);
+
+        auto t0 = Clock::now();
+        save_snapshot(original, path);
+        const double save_ms = elapsed_ms(t0);
+
+        std::ifstream probe(path, std::ios::binary | std::ios::ate);
+        const double file_mib = static_cast<double>(probe.tellg()) / (1024.0 * 1024.0);
+
+        std::printf("кімнат=%d файл=%.1f MiB (%.1f байт/кімнату)\n",
+                    num_rooms, file_mib, file_mib * 1024.0 * 1024.0 / num_rooms);
+        std::printf("збереження        %9.2f ms\n", save_ms);
+
+        bool identical = true;
+        for (bool use_mmap : { true, false }) {
+            GameMap loaded;
+            t0 = Clock::now();
+            load_snapshot(loaded, path, use_mmap);
+            const double load_ms = elapsed_ms(t0);
+            const bool same = map_fingerprint(loaded) == reference;
+            identical = identical && same;
+            std::printf("%-17s %9.2f ms  %s\n", use_mmap ? "завантаження mmap" : "завантаження read",
+                        load_ms, same ? "ідентична" : "ВІДРІЗНЯЄТЬСЯ");
+        }
+
+        // Знімок посеред гри
+        int divergent = 0;
+        const int games = 200;
+        for (int game = 0; game < games; ++game) {
+            GameEngine played;
+            played.start("Тест", static_cast<PlayerClass>(game % 3), 1000 + game);
+            Rng driver(game);
+            for (int step = 0; step < 40 && played.is_running(); ++step) random_action(played, driver);
+
+            save_snapshot(played, path);
+            GameEngine restored;
+            load_snapshot(restored, path);
+
+            Rng driver_copy = driver;
+            for (int step = 0; step < 200; ++step) {
+                if (engine_fingerprint(played) != engine_fingerprint(restored)) {
+                    ++divergent;
+                    break;
+                }
+                if (!played.is_running()) break;
+                random_action(played, driver);
+                random_action(restored, driver_copy);
+            }
+        }
+        std::printf("ігор зі знімком посеред забігу: %d, розбіжностей: %d\n", games, divergent);
+
+        // Пошкоджені знімки: невідомий клас гравця, хибний прапорець симетрії,
+        // сусід поза межами графа, один ворог / предмет у двох кімнатах
+        using snapshot_format::Header;
+        using snapshot_format::RoomRecord;
+        const uint8_t bad_kind = 0xFF;
+        const uint32_t flipped_flags = snapshot_format::has_engine_flag; // без symmetric_graph_flag
+        const uint32_t bad_neighbor = 0xFFFFFFF0u;
+        Header probe_header;
+        std::vector<RoomRecord> probe_rooms;
+        {
+            GameEngine probe_engine;
+            probe_engine.start("Тест", PlayerClass::Archer, 77);
+            save_snapshot(probe_engine, path);
+            std::ifstream in(path, std::ios::binary);
+            in.read(reinterpret_cast<char*>(&probe_header), sizeof(probe_header));
+            probe_rooms.resize(static_cast<size_t>(probe_header.rooms.count));
+            in.seekg(static_cast<std::streamoff>(probe_header.rooms.offset));
+            in.read(reinterpret_cast<char*>(probe_rooms.data()),
+                    static_cast<std::streamsize>(probe_rooms.size() * sizeof(RoomRecord)));
+        }
+        // Зсув поля field кімнати, що отримує чужий індекс, і сам індекс (першої кімнати,
+        // де він є); кімнат у знімку 8..12, вороги й предмети є в кількох
+        auto duplicate_in_room = [&](uint32_t RoomRecord::*field, size_t field_offset, uint32_t& index) {
+            size_t owner = 0;
+            while ((probe_rooms[owner].*field) == MapNode::no_index) ++owner;
+            index = probe_rooms[owner].*field;
+            const size_t other = owner + 1 < probe_rooms.size() ? owner + 1 : 0;
+            return static_cast<size_t>(probe_header.rooms.offset) + other * sizeof(RoomRecord) + field_offset;
+        };
+        uint32_t shared_enemy = 0;
+        uint32_t shared_item = 0;
+        const size_t enemy_patch = duplicate_in_room(&RoomRecord::enemy, offsetof(RoomRecord, enemy), shared_enemy);
+        const size_t item_patch = duplicate_in_room(&RoomRecord::item, offsetof(RoomRecord, item), shared_item);
+        const bool rejected =
+            rejects_corruption(path, offsetof(Header, player), &bad_kind, sizeof(bad_kind)) &&
+            rejects_corruption(path, offsetof(Header, flags), &flipped_flags, sizeof(flipped_flags)) &&
+            rejects_corruption(path, static_cast<size_t>(probe_header.neighbors.offset), &bad_neighbor,
+                               sizeof(bad_neighbor)) &&
+            rejects_corruption(path, enemy_patch, &shared_enemy, sizeof(shared_enemy)) &&
+            rejects_corruption(path, item_patch, &shared_item, sizeof(shared_item));
+        std::printf("пошкоджені знімки відкинуто, гра ціла: %s\n", rejected ? "так" : "НІ");
+
+        std::remove(path.c_str());
+        return identical && divergent == 0 && rejected ? 0 : 2;
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "Помилка: %s\n", error.what());
+        return 1;
+    }
+}
@@ -0,0 +1,77 @@
+#include "Benchmarks.hpp"
+#include "GameEngine.hpp"
+#include "GameMap.hpp"
+#include "Trace.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Трасування (Trace.hpp): ціна одного маркера і приклад траси сесії —
+// послідовна й паралельна генерація карти (події parallel_for у кожному потоці)
+// плюс кілька ігор GameEngine. Траса пишеться у Chrome trace-event JSON.
+//
+// Параметри: [файл (типово dungeon_trace.json)] [потоків (типово 4)]
+
+int run_trace_bench(int argc, char* argv[])
+{
+#ifndef DUNGEON_TRACING
+    (void)argc;
+    (void)argv;
+    std::fprintf(stderr, "Зберіть з DUNGEON_TRACING (qmake CONFIG+=instrumented bench.pro)\n");
+    return 1;
+#else
+    const std::string path = argc > 1 ? argv[1] : "dungeon_trace.json";
+    const unsigned threads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 4;
+
+    // 1. Ціна маркера: порожні області підряд
+    constexpr int markers = 1 << 20;
+    tracing::clear();
+    auto t0 = Clock::now();
+    for (int i = 0; i < markers; ++i) {
+        DUNGEON_TRACE_SCOPE("empty");
+    }
+    const double marker_ns = std::chrono::duration<double, std::nano>(
+        Clock::now() - t0).count() / markers;
+    std::printf("маркер: %.1f нс (запис + два читання годинника)\n", marker_ns);
+
+    // 2. Сесія
+    tracing::clear();
+    {
+        DUNGEON_TRACE_SCOPE("session");
+        GameMap serial;
+        Rng rng(1);
+        serial.generate_map(100000, 50000, 50001, rng);
+
+        GameMap parallel;
+        parallel.generate_map_parallel(100000, 50000, 50001, 1, threads);
+
+        for (int game = 0; game < 20; ++game) {
+            DUNGEON_TRACE_SCOPE("game");
+            GameEngine engine;
+            engine.start("Бот", static_cast<PlayerClass>(game % 3), static_cast<uint64_t>(game));
+            Rng driver(static_cast<uint64_t>(game));
+            for (int turn = 0; engine.is_running() && turn < 1000; ++turn) {
+                DUNGEON_TRACE_SCOPE("turn");
+                if (engine.get_current_enemy()) {
+                    engine.attack();
+                } else if (engine.get_current_item()) {
+                    engine.take_item();
+                } else {
+                    const size_t exits = engine.get_map()->get_num_neighbors(engine.get_current_room_id());
+                    engine.move(static_cast<int>(driver.below(static_cast<uint32_t>(exits))));
+                }
+            }
+        }
+    }
+
+    const size_t events = tracing::event_count();
+    if (!tracing::write_chrome_json(path)) {
+        std::fprintf(stderr, "Не вдалося записати %s\n", path.c_str());
+        return 1;
+    }
+    std::printf("подій: %zu -> %s (chrome://tracing або ui.perfetto.dev)\n", events, path.c_str());
+    return 0;
+#endif
+}
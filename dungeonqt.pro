@@ -8,25 +8,50 @@ CONFIG += c++17
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+# Облік виділень купи за областями й діями (AllocTracker): qmake CONFIG+=alloc_tracking
+alloc_tracking: DEFINES += DUNGEON_ALLOC_TRACKING
+
+# Маркери трасування з експортом у Chrome trace JSON (Trace): qmake CONFIG+=tracing
+tracing: DEFINES += DUNGEON_TRACING
+
 SOURCES += \
+    AllocTracker.cpp \
+    Trace.cpp \
     main.cpp \
     mainwindow.cpp
 
 HEADERS += \
+    AllocTracker.hpp \
+    Arena.hpp \
     Archer.hpp \
     Armor.hpp \
     Character.hpp \
+    ChunkedDungeon.hpp \
+    CombatKernels.hpp \
+    CombatLog.hpp \
+    CombatRules.hpp \
+    CombatStore.hpp \
+    DistanceField.hpp \
     Enemy.hpp \
     Game.hpp \
+    GameEngine.hpp \
     GameMap.hpp \
     Goblin.hpp \
     Graph.hpp \
     Item.hpp \
+    LogModel.hpp \
     Mage.hpp \
     MapNode.hpp \
+    NameTables.hpp \
     Orc.hpp \
+    Parallel.hpp \
+    ParallelBfs.hpp \
     Player.hpp \
     Potion.hpp \
+    Random.hpp \
+    Snapshot.hpp \
+    Trace.hpp \
+    TraversalContext.hpp \
     Warrior.hpp \
     Weapon.hpp \
     Wraith.hpp \
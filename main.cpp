@@ -4,6 +4,8 @@
 #include <QLocale>
 #include <QTranslator>
 
+#include "Trace.hpp"
+
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
@@ -19,5 +21,12 @@ int main(int argc, char *argv[])
     }
     MainWindow w;
     w.show();
-    return a.exec();
+    const int result = a.exec();
+
+#ifdef DUNGEON_TRACING
+    // Траса сесії для chrome://tracing / Perfetto: $DUNGEON_TRACE_FILE або dungeon_trace.json
+    const QByteArray tracePath = qgetenv("DUNGEON_TRACE_FILE");
+    tracing::write_chrome_json(tracePath.isEmpty() ? "dungeon_trace.json" : tracePath.toStdString());
+#endif
+    return result;
 }
@@ -1,6 +1,9 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
-#include <QScrollBar>
+#include <QTimer>
+
+#include "LogModel.hpp"
+#include "Trace.hpp"
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -18,7 +21,7 @@ MainWindow::MainWindow(QWidget *parent)
         "QMainWindow { background-color: #2b2b2b; }"
 
         // Стиль для поля логу (схожий на старий пергамент або термінал)
-        "QTextBrowser#gameLog {"
+        "QListView#gameLog {"
         "   background-color: #1e1e1e;"
         "   color: #e0e0e0;"
         "   border: 2px solid #5c5c5c;"
@@ -65,35 +68,32 @@ MainWindow::MainWindow(QWidget *parent)
         "}"
         );
 
+    // Журнал: модель з обмеженою історією і пакетним додаванням, вид малює лише видимі рядки
+    logModel = new LogModel(LogModel::defaultCapacity, this);
+    ui->gameLog->setModel(logModel);
+    connect(logModel, &LogModel::batchAppended, ui->gameLog, &QListView::scrollToBottom);
+
     game = new Game(this);
 
     // --- 1. СИГНАЛИ ВІД ГРИ ---
 
     // Логування тексту
-    connect(game, &Game::logMessage, this, [this](QString msg){
-        ui->gameLog->append(msg);
-        ui->gameLog->verticalScrollBar()->setValue(ui->gameLog->verticalScrollBar()->maximum());
-    });
+    connect(game, &Game::logMessage, logModel, &LogModel::append);
 
-    // Оновлення кнопок і HP, коли щось змінюється в грі
-    connect(game, &Game::statsUpdated, this, &MainWindow::updateUI);
-    connect(game, &Game::roomUpdated, this, &MainWindow::updateUI);
-    connect(game, &Game::gameStarted, this, &MainWindow::updateUI);
+    // Оновлення кнопок і HP, коли щось змінюється в грі (одне на дію, див. scheduleUpdateUI)
+    connect(game, &Game::statsUpdated, this, &MainWindow::scheduleUpdateUI);
+    connect(game, &Game::roomUpdated, this, &MainWindow::scheduleUpdateUI);
+    connect(game, &Game::gameStarted, this, &MainWindow::scheduleUpdateUI);
 
     // Обробка кінця гри
     connect(game, &Game::gameOver, this, [this](bool victory){
-        updateUI(); // Це викличе нашу нову логіку, яка сховає зайві кнопки
+        scheduleUpdateUI(); // Гра вже не триває — updateUI сховає зайві кнопки
 
         if(victory) {
-            ui->gameLog->append("\n🏆 ВІТАЄМО! ВИ ВИГРАЛИ! (Всі вороги знищені)");
-            // При перемозі теж ховаємо все зайве
-            ui->btnAttack->setVisible(false);
-            ui->btnMove1->setVisible(false);
-            ui->btnMove2->setVisible(false);
-            ui->btnStart->setVisible(true);
+            logModel->append("\n🏆 ВІТАЄМО! ВИ ВИГРАЛИ! (Всі вороги знищені)");
         }
         else {
-            ui->gameLog->append("\n💀 ГРА ЗАКІНЧЕНА. Спробуйте ще раз!");
+            logModel->append("\n💀 ГРА ЗАКІНЧЕНА. Спробуйте ще раз!");
         }
     });
 
@@ -101,8 +101,12 @@ MainWindow::MainWindow(QWidget *parent)
 
     // Нова гра
     connect(ui->btnStart, &QPushButton::clicked, this, [this](){
-        ui->gameLog->clear();
-        ui->hpBar->reset(); // Скидання кольору
+        logModel->clear();
+        // Скидання смужки HP: reset() чистить лише значення, колір задає стиль,
+        // тож прибираємо його й забуваємо закешований колір — updateUI задасть заново
+        ui->hpBar->reset();
+        ui->hpBar->setStyleSheet(QString());
+        hpColorBand = -1;
         // Вмикаємо кнопки назад
         ui->btnMove1->setEnabled(true);
         ui->btnMove2->setEnabled(true);
@@ -129,6 +133,7 @@ MainWindow::MainWindow(QWidget *parent)
     ui->btnMove1->setVisible(false);
     ui->btnMove2->setVisible(false);
     ui->hpBar->setValue(0);
+    ui->hpBar->setFormat("%v / %m HP");
 }
 
 MainWindow::~MainWindow()
@@ -136,26 +141,42 @@ MainWindow::~MainWindow()
     delete ui;
 }
 
+void MainWindow::scheduleUpdateUI()
+{
+    if (uiUpdatePending) return;
+    uiUpdatePending = true;
+    QTimer::singleShot(0, this, &MainWindow::updateUI);
+}
+
 void MainWindow::updateUI()
 {
+    DUNGEON_TRACE_SCOPE("MainWindow::updateUI");
+    uiUpdatePending = false;
+
     // 1. Оновлення HP (це робимо завжди, навіть якщо мертвий)
     int hp = game->getPlayerHP();
     int maxHp = game->getPlayerMaxHP();
     ui->hpBar->setMaximum(maxHp);
     ui->hpBar->setValue(hp);
-    ui->hpBar->setFormat("%v / %m HP");
 
-    // Кольори смужки
-    if (hp > maxHp * 0.5) ui->hpBar->setStyleSheet("QProgressBar::chunk { background-color: #2ecc71; }");
-    else if (hp > maxHp * 0.25) ui->hpBar->setStyleSheet("QProgressBar::chunk { background-color: #f1c40f; }");
-    else ui->hpBar->setStyleSheet("QProgressBar::chunk { background-color: #e74c3c; }");
+    // Кольори смужки: setStyleSheet перераховує стиль віджета, тож лише при зміні кольору
+    const int band = hp > maxHp * 0.5 ? 0 : (hp > maxHp * 0.25 ? 1 : 2);
+    if (band != hpColorBand) {
+        static const char* const bandStyles[] = {
+            "QProgressBar::chunk { background-color: #2ecc71; }",
+            "QProgressBar::chunk { background-color: #f1c40f; }",
+            "QProgressBar::chunk { background-color: #e74c3c; }"
+        };
+        ui->hpBar->setStyleSheet(bandStyles[band]);
+        hpColorBand = band;
+    }
 
-    // --- ВАЖЛИВА ЗМІНА: ЯКЩО ГРАВЕЦЬ МЕРТВИЙ - ХОВАЄМО ВСЕ І ВИХОДИМО ---
-    if (hp <= 0) {
+    // --- ЯКЩО ГРАВЕЦЬ МЕРТВИЙ АБО ГРА ЗАКІНЧЕНА - ХОВАЄМО ВСЕ І ВИХОДИМО ---
+    if (hp <= 0 || !game->isRunning()) {
         ui->btnAttack->setVisible(false);
         ui->btnMove1->setVisible(false);
         ui->btnMove2->setVisible(false);
-        ui->btnStart->setVisible(true); // Кнопку "Нова гра" завжди показуємо при смерті
+        ui->btnStart->setVisible(true); // Кнопку "Нова гра" завжди показуємо наприкінці гри
         return;
     }
     // -------------------------------------------------------------------
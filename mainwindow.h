@@ -4,6 +4,8 @@
 #include <QMainWindow>
 #include "Game.hpp" // Підключаємо нашу гру
 
+class LogModel;
+
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
@@ -17,12 +19,20 @@ public:
     ~MainWindow();
 
 private slots:
-    // Слот для оновлення інтерфейсу (коли гра надсилає сигнал)
+    // Оновлення інтерфейсу; викликається раз за ітерацію циклу подій через scheduleUpdateUI
     void updateUI();
 
 private:
     Ui::MainWindow *ui;
     Game *game; // Вказівник на об'єкт гри
+    LogModel *logModel; // Рядки журналу для ui->gameLog
+
+    // Одна дія гравця надсилає кілька сигналів (statsUpdated, roomUpdated, ...):
+    // вони лише ставлять прапорець, а updateUI виконується один раз у черзі подій
+    bool uiUpdatePending = false;
+    int hpColorBand = -1; // Поточний колір смужки HP (0 — зелений, 1 — жовтий, 2 — червоний)
+
+    void scheduleUpdateUI();
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,559 @@
+#include "GameEngine.hpp"
+#include "CombatLog.hpp"
+#include "CombatStore.hpp"
+#include "Goblin.hpp"
+#include "Orc.hpp"
+#include "Wraith.hpp"
+#include "Parallel.hpp"
+#include "Random.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Пакетний симулятор балансу: автоматично проходить підземелля всіма класами
+// на всіх ядрах і рахує статистику забігів та окремих боїв клас/ворог.
+//
+// Бот: б'є ворога в кімнаті до кінця бою, підбирає предмети і йде до
+// найближчої кімнати з ворогом (multi-source поле відстаней GameMap).
+//
+// Забіг i завжди грається із зерном, виведеним з (--seed, i), тож результат
+// не залежить від кількості потоків, а будь-який забіг можна повторити.
+//
+// Режим --duels N: лише бої клас/ворог (N на кожну пару) у CombatStore (SoA),
+// без карти й без об'єктів Character на кожен бій.
+//
+// --verify: після кожної дії порівнює лічильники живих ворогів GameMap
+// (загальний і за типом) з повним проходом карти; бот тоді частіше ходить
+// випадково. Перед забігами — крайові випадки Rng::below і дуелі всіх пар
+// клас/ворог двома шляхами: об'єкти Character (віртуальні attack / take_damage)
+// проти CombatStore::attack — HP обох бійців мають збігатися після кожного удару;
+// CombatLog::render має дослівно відтворити колишній текст attack / heal.
+// Ненульовий код виходу, якщо знайдено розбіжність (make check).
+
+namespace {
+
+constexpr int num_classes = 3;
+constexpr int num_enemy_types = 3;
+constexpr int histogram_buckets = 10;
+constexpr int max_turns = 10000;
+
+const char* const class_names[num_classes] = { "Воїн", "Маг", "Лучник" };
+const char* const enemy_names[num_enemy_types] = { "Гоблін", "Орк", "Примара" };
+
+// Гістограма залишку HP гравця у відсотках від максимуму (10 кошиків по 10%)
+struct HpHistogram {
+    std::array<uint64_t, histogram_buckets> buckets{};
+
+    void add(int hp, int max_hp) {
+        int bucket = max_hp > 0 ? hp * histogram_buckets / max_hp : 0;
+        if (bucket >= histogram_buckets) bucket = histogram_buckets - 1;
+        if (bucket < 0) bucket = 0;
+        ++buckets[bucket];
+    }
+
+    void merge(const HpHistogram& other) {
+        for (int i = 0; i < histogram_buckets; ++i) buckets[i] += other.buckets[i];
+    }
+};
+
+struct RunStats {
+    uint64_t runs = 0;
+    uint64_t wins = 0;
+    uint64_t turns = 0;
+    HpHistogram hp_left; // лише для перемог
+
+    void merge(const RunStats& other) {
+        runs += other.runs;
+        wins += other.wins;
+        turns += other.turns;
+        hp_left.merge(other.hp_left);
+    }
+};
+
+struct FightStats {
+    uint64_t fights = 0;
+    uint64_t wins = 0;
+    uint64_t rounds = 0;
+    HpHistogram hp_left; // після виграного бою
+
+    void merge(const FightStats& other) {
+        fights += other.fights;
+        wins += other.wins;
+        rounds += other.rounds;
+        hp_left.merge(other.hp_left);
+    }
+};
+
+struct SimStats {
+    std::array<RunStats, num_classes> runs{};
+    std::array<std::array<FightStats, num_enemy_types>, num_classes> fights{};
+    uint64_t counter_checks = 0;      // --verify
+    uint64_t counter_mismatches = 0;
+
+    void merge(const SimStats& other) {
+        counter_checks += other.counter_checks;
+        counter_mismatches += other.counter_mismatches;
+        for (int c = 0; c < num_classes; ++c) {
+            runs[c].merge(other.runs[c]);
+            for (int e = 0; e < num_enemy_types; ++e) fights[c][e].merge(other.fights[c][e]);
+        }
+    }
+};
+
+int enemy_type_of(const Enemy* enemy) {
+    if (dynamic_cast<const Orc*>(enemy)) return 1;
+    if (dynamic_cast<const Wraith*>(enemy)) return 2;
+    return 0;
+}
+
+// Лічильники живих ворогів GameMap проти повного проходу всіх кімнат
+bool enemy_counters_match(const GameMap& map) {
+    std::array<uint32_t, combat_kind_count> by_kind{};
+    uint32_t total = 0;
+    for (size_t id = 0; id < map.get_num_rooms(); ++id) {
+        const Enemy* enemy = map.get_enemy(*map.get_node_by_id(static_cast<int>(id)));
+        if (enemy && enemy->is_alive()) {
+            ++total;
+            ++by_kind[static_cast<size_t>(enemy->get_combat_kind())];
+        }
+    }
+
+    if (total != map.get_live_enemy_count()) return false;
+    if (map.allEnemiesDefeated() != (total == 0)) return false;
+    for (int kind = 0; kind < combat_kind_count; ++kind) {
+        if (by_kind[kind] != map.get_live_enemy_count(static_cast<CombatKind>(kind))) return false;
+    }
+    return true;
+}
+
+void verify_counters(const GameEngine& engine, SimStats& stats) {
+    ++stats.counter_checks;
+    if (!enemy_counters_match(*engine.get_map())) ++stats.counter_mismatches;
+}
+
+// Крайові випадки Rng::below: порожній діапазон (ізольована кімната), одиничний
+// і найбільший — результат у межах, below(0) не зсуває стан генератора
+bool rng_edge_cases_hold() {
+    Rng rng(42);
+    Rng reference(42);
+    if (rng.below(0) != 0 || rng.next() != reference.next()) return false;
+    for (int i = 0; i < 1000; ++i) {
+        if (rng.below(1) != 0) return false;
+        if (rng.below(3) >= 3) return false;
+        if (rng.below(0xFFFFFFFFu) == 0xFFFFFFFFu) return false;
+    }
+    return true;
+}
+
+// Сценарій боїв з відомим текстом: саме ці рядки повертали attack / take_damage /
+// heal до переходу на структурований журнал. Зерно 2 дає лучнику спершу крит,
+// потім звичайний постріл
+bool combat_log_renders_legacy_text() {
+    static const char* const expected[] = {
+        "⚔️ Герой (Воїн) завдає ПОТУЖНОГО УДАРУ! Goblin отримує 27 шкоди! (HP: 13/40)",
+        "👺 Goblin (Гоблін) швидко атакує! Герой отримує 1 шкоди! (HP: 149/150)",
+        "🔥 Маг кастує закляття! Orc отримує 30 шкоди (ІГНОР ЗАХИСТУ).",
+        "👹 Orc (Орк) завдає БРУТАЛЬНОГО УДАРУ! Маг отримує 17 шкоди! (HP: 63/80)",
+        "🔥 Маг кастує закляття! Goblin отримує 30 шкоди (ІГНОР ЗАХИСТУ).",
+        "🏹🎯 Лучник завдає КРИТИЧНОГО УДАРУ! 👻 Wraith проходить крізь атаку (50% резист)! "
+            "Отримує лише 15 шкоди. (HP: 45/60)",
+        "🏹 Лучник стріляє з лука. 👻 Wraith проходить крізь атаку (50% резист)! Отримує лише 5 шкоди. (HP: 40/60)",
+        "👻 Wraith (Примара) використовує СПЕКТРАЛЬНЕ ВИСМОКТУВАННЯ! Лучник отримує 10 шкоди! (HP: 90/100) "
+            "(Примара відновила сили)",
+        "Wraith відновлює 6 HP. (HP: 46/60)",
+        "👺 Goblin (Гоблін) швидко атакує! Герой не отримує пошкоджень.",
+    };
+    constexpr size_t num_expected = sizeof(expected) / sizeof(expected[0]);
+
+    CombatLog log;
+    Warrior warrior("Герой");
+    Mage mage("Маг");
+    Rng archer_rng(2);
+    Archer archer("Лучник", &archer_rng);
+    Goblin goblin;
+    Orc orc;
+    Goblin wounded_goblin;
+    Wraith wraith;
+    Goblin weak_goblin;
+    wounded_goblin.set_hp(10);
+    weak_goblin.modify_attack_power(-10);
+    for (Character* character : std::initializer_list<Character*>{
+             &warrior, &mage, &archer, &goblin, &orc, &wounded_goblin, &wraith, &weak_goblin }) {
+        character->attach_combat_log(&log);
+    }
+
+    warrior.attack(goblin);
+    goblin.attack(warrior);
+    mage.attack(orc);
+    orc.attack(mage);
+    mage.attack(wounded_goblin); // Надлишок: текст показує силу закляття, а не залишок HP
+    archer.attack(wraith);
+    archer.attack(wraith);
+    wraith.attack(archer);       // Висмоктування і самолікування — дві події
+    weak_goblin.attack(warrior); // Атака без сили: шкоди немає
+
+    if (log.total_recorded() != num_expected) return false;
+    size_t index = 0;
+    bool same = true;
+    log.for_each_since(0, [&](const CombatEvent& event) {
+        if (log.render(event) != expected[index++]) same = false;
+    });
+    return same;
+}
+
+struct DuelCheck {
+    uint64_t duels = 0;
+    uint64_t mismatched_duels = 0;
+};
+
+// Одна дуель двома шляхами з однаковим зерном кидків (крит лучника): об'єкти
+// Character і CombatStore. Стартові атака й захист трохи розкидані, щоб
+// зачепити і шкоду нижче захисту, і добивання з надлишком
+bool duel_paths_match(int class_index, int enemy_type, uint64_t seed) {
+    Rng setup(seed);
+    Rng object_rng(~seed);
+    Rng store_rng(~seed);
+
+    std::unique_ptr<Character> player;
+    switch (class_index) {
+    case 0: player = std::make_unique<Warrior>("Воїн"); break;
+    case 1: player = std::make_unique<Mage>("Маг"); break;
+    default: player = std::make_unique<Archer>("Лучник", &object_rng); break;
+    }
+    std::unique_ptr<Character> enemy;
+    switch (enemy_type) {
+    case 0: enemy = std::make_unique<Goblin>(); break;
+    case 1: enemy = std::make_unique<Orc>(); break;
+    default: enemy = std::make_unique<Wraith>(); break;
+    }
+    player->modify_attack_power(static_cast<int>(setup.below(30)) - 10);
+    player->modify_defense(static_cast<int>(setup.below(30)) - 5);
+    enemy->modify_attack_power(static_cast<int>(setup.below(30)) - 10);
+    enemy->modify_defense(static_cast<int>(setup.below(40)) - 5);
+
+    CombatStore store;
+    const CombatStore::index_type p = store.add(*player);
+    const CombatStore::index_type e = store.add(*enemy);
+
+    // Як у GameEngine::attack: спершу гравець, потім вцілілий ворог
+    for (int round = 0; round < max_turns && player->is_alive() && enemy->is_alive(); ++round) {
+        player->attack(*enemy);
+        store.attack(p, e, store_rng);
+        if (enemy->get_hp() != store.get_hp(e) || player->get_hp() != store.get_hp(p)) return false;
+        if (!enemy->is_alive()) break;
+
+        enemy->attack(*player);
+        store.attack(e, p, store_rng);
+        if (enemy->get_hp() != store.get_hp(e) || player->get_hp() != store.get_hp(p)) return false;
+    }
+    return store.is_alive(p) == player->is_alive() && store.is_alive(e) == enemy->is_alive();
+}
+
+DuelCheck check_duel_paths(uint64_t seed) {
+    constexpr int duels_per_matchup = 500;
+    DuelCheck check;
+    for (int c = 0; c < num_classes; ++c) {
+        for (int e = 0; e < num_enemy_types; ++e) {
+            for (int i = 0; i < duels_per_matchup; ++i) {
+                uint64_t duel_seed = seed + static_cast<uint64_t>((c * num_enemy_types + e) * duels_per_matchup + i);
+                ++check.duels;
+                if (!duel_paths_match(c, e, Rng::splitmix64(duel_seed))) ++check.mismatched_duels;
+            }
+        }
+    }
+    return check;
+}
+
+// Вихід, що веде найкоротшим шляхом до кімнати з ворогом (-1, якщо ворогів немає)
+int choose_exit(const GameEngine& engine, Rng& rng) {
+    GameMap* map = engine.get_map();
+    std::vector<int> enemy_rooms;
+    for (size_t id = 0; id < map->get_num_rooms(); ++id) {
+        if (map->get_node_by_id(static_cast<int>(id))->has_enemy()) {
+            enemy_rooms.push_back(static_cast<int>(id));
+        }
+    }
+    if (enemy_rooms.empty()) return -1;
+
+    DistanceField field = map->build_distance_field(enemy_rooms);
+    int best_exit = -1;
+    uint32_t best_distance = DistanceField::unreachable;
+    int ties = 0;
+    int exit_index = 0;
+    map->for_each_neighbor(engine.get_current_room_id(), [&](MapNode* node) {
+        uint32_t distance = field.at(static_cast<size_t>(node->get_id()));
+        if (distance < best_distance) {
+            best_distance = distance;
+            best_exit = exit_index;
+            ties = 1;
+        } else if (distance == best_distance && distance != DistanceField::unreachable) {
+            // Рівноцінні виходи обираємо випадково (reservoir sampling)
+            if (rng.below(static_cast<uint32_t>(++ties)) == 0) best_exit = exit_index;
+        }
+        ++exit_index;
+    });
+    return best_exit;
+}
+
+void simulate_run(int class_index, uint64_t seed, bool verify, SimStats& stats) {
+    GameEngine engine;
+    engine.start("Бот", static_cast<PlayerClass>(class_index), seed);
+    Rng rng(~seed); // рішення бота — окремий потік випадковості від гри
+    if (verify) verify_counters(engine, stats);
+
+    int turns = 0;
+    while (engine.is_running() && turns < max_turns) {
+        MapNode* room = engine.get_current_room();
+
+        if (room->has_enemy()) {
+            const int enemy_type = enemy_type_of(engine.get_current_enemy());
+            FightStats& fight = stats.fights[class_index][enemy_type];
+            int rounds = 0;
+            while (engine.is_running() && room->has_enemy() && turns < max_turns) {
+                engine.attack();
+                ++rounds;
+                ++turns;
+                if (verify) verify_counters(engine, stats);
+            }
+            const Player* player = engine.get_player();
+            ++fight.fights;
+            fight.rounds += static_cast<uint64_t>(rounds);
+            if (player->is_alive()) {
+                ++fight.wins;
+                fight.hp_left.add(player->get_hp(), player->get_max_hp());
+            }
+            continue;
+        }
+
+        if (room->has_item()) {
+            engine.take_item();
+            ++turns;
+            if (verify) verify_counters(engine, stats);
+        }
+
+        int exit_index = choose_exit(engine, rng);
+        if (exit_index < 0) break; // ворогів не лишилося (гра вже має бути виграна)
+        if (verify && rng.below(4) == 0) {
+            // Випадковий хід для ширшого покриття станів
+            auto exits = engine.get_map()->get_num_neighbors(engine.get_current_room_id());
+            exit_index = static_cast<int>(rng.below(static_cast<uint32_t>(exits)));
+        }
+        engine.move(exit_index);
+        ++turns;
+        if (verify) verify_counters(engine, stats);
+    }
+
+    RunStats& run = stats.runs[class_index];
+    const Player* player = engine.get_player();
+    ++run.runs;
+    run.turns += static_cast<uint64_t>(turns);
+    if (player->is_alive() && engine.get_map()->allEnemiesDefeated()) {
+        ++run.wins;
+        run.hp_left.add(player->get_hp(), player->get_max_hp());
+    }
+}
+
+// Дуелі пачками: усі бійці пачки лежать в одному CombatStore, раунд — два attack_batch
+constexpr size_t duel_block = 4096;
+
+void simulate_duel_block(int class_index, int enemy_type, size_t count, uint64_t seed, FightStats& stats) {
+    static const Warrior warrior("Воїн");
+    static const Mage mage("Маг");
+    static const Archer archer("Лучник");
+    static const Goblin goblin;
+    static const Orc orc;
+    static const Wraith wraith;
+    const Character* const player_prototypes[num_classes] = { &warrior, &mage, &archer };
+    const Character* const enemy_prototypes[num_enemy_types] = { &goblin, &orc, &wraith };
+
+    CombatStore store;
+    store.reserve(count * 2);
+    std::vector<CombatStore::index_type> players(count);
+    std::vector<CombatStore::index_type> enemies(count);
+    for (size_t i = 0; i < count; ++i) {
+        players[i] = store.add(*player_prototypes[class_index]);
+        enemies[i] = store.add(*enemy_prototypes[enemy_type]);
+    }
+
+    Rng rng(seed);
+    std::vector<int> rounds(count, 0);
+    for (int round = 0; round < max_turns; ++round) {
+        bool any_active = false;
+        for (size_t i = 0; i < count; ++i) {
+            if (store.is_alive(players[i]) && store.is_alive(enemies[i])) {
+                ++rounds[i];
+                any_active = true;
+            }
+        }
+        if (!any_active) break;
+
+        // Як у GameEngine::attack: спершу гравець, потім вцілілий ворог
+        store.attack_batch(players.data(), enemies.data(), count, rng);
+        store.attack_batch(enemies.data(), players.data(), count, rng);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        ++stats.fights;
+        stats.rounds += static_cast<uint64_t>(rounds[i]);
+        if (store.is_alive(players[i])) {
+            ++stats.wins;
+            stats.hp_left.add(store.get_hp(players[i]), store.get_max_hp(players[i]));
+        }
+    }
+}
+
+void print_histogram(const HpHistogram& histogram) {
+    uint64_t total = 0;
+    for (uint64_t count : histogram.buckets) total += count;
+    std::printf("    HP%%:");
+    for (int i = 0; i < histogram_buckets; ++i) {
+        double share = total ? 100.0 * static_cast<double>(histogram.buckets[i]) / static_cast<double>(total) : 0.0;
+        std::printf(" %d-%d:%.1f%%", i * 10, i * 10 + 10, share);
+    }
+    std::printf("\n");
+}
+
+void print_usage(const char* program) {
+    std::printf("Використання: %s [--runs N | --duels N] [--threads T] [--seed S] [--verify]\n"
+                "  --runs N     забігів на кожен клас (типово 1000000)\n"
+                "  --duels N    лише дуелі: N боїв на кожну пару клас/ворог\n"
+                "  --threads T  кількість потоків (типово всі ядра)\n"
+                "  --seed S     базове зерно забігів (типово 1)\n"
+                "  --verify     звіряти лічильники ворогів з повним проходом карти\n", program);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    uint64_t runs_per_class = 1000000;
+    uint64_t duels_per_matchup = 0;
+    unsigned threads = 0;
+    uint64_t seed = 1;
+    bool verify = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs_per_class = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--duels") == 0 && i + 1 < argc) {
+            duels_per_matchup = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--verify") == 0) {
+            verify = true;
+        } else {
+            print_usage(argv[0]);
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+    threads = resolve_thread_count(threads);
+
+    if (verify && !rng_edge_cases_hold()) {
+        std::fprintf(stderr, "--verify: Rng::below вийшов за межі діапазону\n");
+        return 2;
+    }
+    if (verify && !combat_log_renders_legacy_text()) {
+        std::fprintf(stderr, "--verify: CombatLog::render не відтворює колишній текст бою\n");
+        return 2;
+    }
+    const DuelCheck duel_check = verify ? check_duel_paths(seed) : DuelCheck();
+
+    if (duels_per_matchup > 0) {
+        const size_t blocks_per_matchup = static_cast<size_t>((duels_per_matchup + duel_block - 1) / duel_block);
+        const size_t num_matchups = num_classes * num_enemy_types;
+        std::vector<std::array<FightStats, num_classes * num_enemy_types>> per_thread(threads);
+
+        auto t0 = std::chrono::steady_clock::now();
+        parallel_for(num_matchups * blocks_per_matchup, threads, [&](size_t begin, size_t end, unsigned t) {
+            for (size_t block = begin; block < end; ++block) {
+                const size_t matchup = block / blocks_per_matchup;
+                const size_t first = (block % blocks_per_matchup) * duel_block;
+                const size_t count = static_cast<size_t>(std::min<uint64_t>(duel_block, duels_per_matchup - first));
+                uint64_t block_seed = seed + block;
+                simulate_duel_block(static_cast<int>(matchup / num_enemy_types), static_cast<int>(matchup % num_enemy_types),
+                                    count, Rng::splitmix64(block_seed), per_thread[t][matchup]);
+            }
+        });
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        std::printf("Дуелей: %llu (%u потоків, %.2f с)\n\n",
+                    static_cast<unsigned long long>(duels_per_matchup * num_matchups), threads, seconds);
+        for (size_t matchup = 0; matchup < num_matchups; ++matchup) {
+            FightStats fight;
+            for (const auto& stats : per_thread) fight.merge(stats[matchup]);
+            std::printf("%s vs %-8s виграно %.2f%%, раундів у середньому %.2f\n",
+                        class_names[matchup / num_enemy_types], enemy_names[matchup % num_enemy_types],
+                        100.0 * static_cast<double>(fight.wins) / static_cast<double>(fight.fights),
+                        static_cast<double>(fight.rounds) / static_cast<double>(fight.fights));
+            print_histogram(fight.hp_left);
+        }
+        return 0;
+    }
+
+    const uint64_t total_runs = runs_per_class * num_classes;
+    std::vector<SimStats> per_thread(threads);
+
+    auto t0 = std::chrono::steady_clock::now();
+    parallel_for(static_cast<size_t>(total_runs), threads, [&](size_t begin, size_t end, unsigned t) {
+        // Кожен забіг має власний Rng усередині GameEngine — жодного спільного стану між потоками
+        for (size_t i = begin; i < end; ++i) {
+            uint64_t run_seed = seed + i;
+            simulate_run(static_cast<int>(i % num_classes), Rng::splitmix64(run_seed), verify, per_thread[t]);
+        }
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    SimStats total;
+    for (const auto& stats : per_thread) total.merge(stats);
+
+    std::printf("Забігів: %llu (%u потоків, %.2f с, %.0f забігів/с)\n\n",
+                static_cast<unsigned long long>(total_runs), threads, seconds,
+                seconds > 0 ? static_cast<double>(total_runs) / seconds : 0.0);
+
+    for (int c = 0; c < num_classes; ++c) {
+        const RunStats& run = total.runs[c];
+        std::printf("%s: перемог %.2f%%, в середньому %.1f ходів\n", class_names[c],
+                    run.runs ? 100.0 * static_cast<double>(run.wins) / static_cast<double>(run.runs) : 0.0,
+                    run.runs ? static_cast<double>(run.turns) / static_cast<double>(run.runs) : 0.0);
+        print_histogram(run.hp_left);
+
+        for (int e = 0; e < num_enemy_types; ++e) {
+            const FightStats& fight = total.fights[c][e];
+            std::printf("  vs %-8s боїв %llu, виграно %.2f%%, раундів у середньому %.2f\n", enemy_names[e],
+                        static_cast<unsigned long long>(fight.fights),
+                        fight.fights ? 100.0 * static_cast<double>(fight.wins) / static_cast<double>(fight.fights) : 0.0,
+                        fight.fights ? static_cast<double>(fight.rounds) / static_cast<double>(fight.fights) : 0.0);
+            print_histogram(fight.hp_left);
+        }
+        std::printf("\n");
+    }
+
+    if (verify) {
+        std::printf("Перевірка лічильників ворогів: %llu перевірок, розбіжностей %llu\n",
+                    static_cast<unsigned long long>(total.counter_checks),
+                    static_cast<unsigned long long>(total.counter_mismatches));
+        std::printf("Дуелі Character проти CombatStore: %llu дуелей, розбіжностей %llu\n",
+                    static_cast<unsigned long long>(duel_check.duels),
+                    static_cast<unsigned long long>(duel_check.mismatched_duels));
+        if (total.counter_mismatches > 0) {
+            std::fprintf(stderr, "--verify: лічильники живих ворогів розійшлися з картою\n");
+            return 2;
+        }
+        if (duel_check.mismatched_duels > 0) {
+            std::fprintf(stderr, "--verify: CombatStore::attack розійшовся з класами Character\n");
+            return 2;
+        }
+    }
+    return 0;
+}
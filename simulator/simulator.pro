@@ -0,0 +1,18 @@
+# Консольний симулятор балансу без Qt: qmake simulator.pro && make && ./dungeon_sim --help
+
+TEMPLATE = app
+TARGET = dungeon_sim
+
+CONFIG += console c++17 thread
+CONFIG -= app_bundle qt
+
+INCLUDEPATH += ..
+
+SOURCES += \
+    main.cpp
+
+# make check: лічильники живих ворогів проти повного проходу карти (--verify);
+# розбіжність дає ненульовий код виходу
+check.commands = ./$$TARGET --verify --runs 2000
+check.depends = $(TARGET)
+QMAKE_EXTRA_TARGETS += check